@@ -0,0 +1,330 @@
+﻿#include "Backtest.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+constexpr size_t BotGrain = 64; //병렬 작업 하나가 맡는 봇 수
+constexpr size_t RankGrain = 4; //모멘텀 순위 계산에서 작업 하나가 맡는 날 수
+
+//봇 하나의 포트폴리오 (작업마다 하나를 만들어 봇마다 초기화해서 재사용)
+struct Portfolio {
+    double cash = 0;
+    vector<int> amounts; //회사별 보유량
+    vector<int> entryRow; //회사별 매수한 행 (뉴스 전략의 보유 기간)
+    vector<int> held; //보유 중인 회사 (매수 순서)
+    int trades = 0;
+
+    void reset(double startCash, int companies) {
+        cash = startCash;
+        amounts.assign(companies, 0);
+        entryRow.assign(companies, 0);
+        held.clear();
+        trades = 0;
+    }
+    bool holds(int company) const { return amounts[company] > 0; }
+};
+
+//경로의 시장 조성 호가로 체결 (buyStock/sellStock과 같은 규칙, 단 가격은 움직이지 않음)
+class Trader {
+public:
+    explicit Trader(const MarketPath& path) : m_path(path) {}
+
+    //budget 안에서 살 수 있는 만큼 시장가 매수 (호가 물량이 모자라면 거기까지)
+    void buy(Portfolio& p, int row, int company, double budget) {
+        const double price = m_path.prices(row)[company];
+        if (price <= 0) return;
+        Market::makerLevels(m_path.seed(), m_path.firstDay() + row, company, price, m_asks, m_bids);
+        const int64_t limit = (int64_t)floor(min(budget, p.cash));
+        int64_t filled = 0, cost = 0;
+        for (int k = 0; k < Market::BookLevels; k++) {
+            const int64_t want = min(m_asks[k].quantity, (limit - cost) / m_asks[k].price);
+            if (want <= 0) break;
+            filled += want;
+            cost += want * m_asks[k].price;
+            if (want < m_asks[k].quantity) break;
+        }
+        if (filled == 0) return;
+        p.cash -= (double)cost;
+        if (p.amounts[company] == 0) {
+            p.held.push_back(company);
+            p.entryRow[company] = row;
+        }
+        p.amounts[company] += (int)filled;
+        p.trades++;
+    }
+
+    //보유량 전부 시장가 매도 (매수 호가가 모자라면 남은 주식은 계속 보유)
+    void sellAll(Portfolio& p, int row, int company) {
+        const int owned = p.amounts[company];
+        if (owned <= 0) return;
+        Market::makerLevels(m_path.seed(), m_path.firstDay() + row, company, m_path.prices(row)[company], m_asks, m_bids);
+        int64_t filled = 0, proceeds = 0;
+        for (int k = 0; k < Market::BookLevels && filled < owned; k++) {
+            const int64_t take = min<int64_t>(owned - filled, m_bids[k].quantity);
+            filled += take;
+            proceeds += take * m_bids[k].price;
+        }
+        if (filled == 0) return;
+        p.cash += (double)proceeds;
+        p.amounts[company] -= (int)filled;
+        if (p.amounts[company] == 0) p.held.erase(find(p.held.begin(), p.held.end(), company));
+        p.trades++;
+    }
+
+    double value(const Portfolio& p, int row) const {
+        const double* prices = m_path.prices(row);
+        double total = p.cash;
+        for (int c : p.held) total += prices[c] * p.amounts[c];
+        return total;
+    }
+
+private:
+    const MarketPath& m_path;
+    Market::MakerLevel m_asks[Market::BookLevels];
+    Market::MakerLevel m_bids[Market::BookLevels];
+};
+
+//lookback별 모멘텀 순위 (행마다 상승률 상위 width개 회사, 모자라면 -1), 모든 봇이 읽기 전용으로 공유
+struct MomentumRanks {
+    int lookback = 0;
+    int width = 0;
+    vector<int> top; //days × width
+    const int* row(int t) const { return top.data() + (size_t)t * width; }
+};
+
+void buildRanks(const MarketPath& path, MomentumRanks& ranks, ThreadPool* pool) {
+    const int companies = path.companyCount();
+    ranks.top.assign((size_t)path.days() * ranks.width, -1);
+    auto step = [&](size_t begin, size_t end) {
+        vector<pair<double, int>> scored;
+        for (size_t t = begin; t < end; t++) {
+            const double* now = path.prices((int)t);
+            const double* then = path.prices(max(0, (int)t - ranks.lookback));
+            scored.clear();
+            for (int c = 0; c < companies; c++) {
+                if (then[c] <= 0) continue;
+                const double rate = now[c] / then[c] - 1.0;
+                if (rate > 0) scored.push_back({ -rate, c }); //상승률 내림차순, 같으면 회사 번호 순
+            }
+            const size_t n = min(scored.size(), (size_t)ranks.width);
+            partial_sort(scored.begin(), scored.begin() + n, scored.end());
+            int* out = ranks.top.data() + t * ranks.width;
+            for (size_t i = 0; i < n; i++) out[i] = scored[i].second;
+        }
+    };
+    if (pool) pool->parallelFor(0, (size_t)path.days(), RankGrain, step);
+    else step(0, (size_t)path.days());
+}
+
+//작업 하나가 쓰는 재사용 버퍼
+struct BotScratch {
+    Portfolio portfolio;
+    vector<int> picks;
+};
+
+void runBot(const MarketPath& path, const BotSpec& bot, const MomentumRanks* ranks, Trader& trader, BotScratch& s) {
+    const int companies = path.companyCount();
+    Portfolio& p = s.portfolio;
+    p.reset(path.startCash(), companies);
+    if (companies == 0) return;
+    const int picks = max(1, min(bot.picks, companies));
+
+    for (int t = 0; t < path.days(); t++) {
+        switch (bot.strategy) {
+        case Strategy::BuyAndHold:
+            if (t == 0) {
+                s.picks.resize(companies);
+                for (int c = 0; c < companies; c++) s.picks[c] = c;
+                RandomStream(bot.seed, RandomStream::Trader, 0, 0).shuffle(s.picks.data(), companies);
+                for (int i = 0; i < picks; i++) trader.buy(p, t, s.picks[i], p.cash / (picks - i));
+            }
+            break;
+        case Strategy::Momentum: {
+            //상위 목록에서 빠진 종목을 팔고 새로 들어온 종목을 남은 현금으로 균등하게 삼
+            const int* top = ranks->row(t);
+            for (size_t h = p.held.size(); h-- > 0;) {
+                const int c = p.held[h];
+                if (find(top, top + picks, c) == top + picks) trader.sellAll(p, t, c);
+            }
+            s.picks.clear();
+            for (int i = 0; i < picks && top[i] >= 0; i++)
+                if (!p.holds(top[i])) s.picks.push_back(top[i]);
+            for (size_t i = 0; i < s.picks.size(); i++) trader.buy(p, t, s.picks[i], p.cash / (double)(s.picks.size() - i));
+            break;
+        }
+        case Strategy::NewsReactive: {
+            //보유 기간이 지난 종목 정리
+            for (size_t h = p.held.size(); h-- > 0;) {
+                const int c = p.held[h];
+                if (t - p.entryRow[c] >= bot.lookback) trader.sellAll(p, t, c);
+            }
+            //악재는 팔고, 호재는 자리가 남는 만큼 삼
+            s.picks.clear();
+            for (const PathEvent* e = path.eventsBegin(t); e != path.eventsEnd(t); e++) {
+                if (e->impact <= -bot.threshold) {
+                    trader.sellAll(p, t, e->company);
+                } else if (e->impact >= bot.threshold && !p.holds(e->company) &&
+                           find(s.picks.begin(), s.picks.end(), e->company) == s.picks.end()) {
+                    s.picks.push_back(e->company);
+                }
+            }
+            const size_t slots = (size_t)max(0, picks - (int)p.held.size());
+            if (s.picks.size() > slots) s.picks.resize(slots);
+            for (size_t i = 0; i < s.picks.size(); i++) trader.buy(p, t, s.picks[i], p.cash / (double)(s.picks.size() - i));
+            break;
+        }
+        }
+    }
+}
+
+}
+
+MarketPath MarketPath::record(const Market& market) {
+    Market m(market);
+    m.setIntraday(IntradayConfig{});
+    //남은 지정가 주문은 경로를 움직이므로 취소하고 순수한 시장 흐름만 기록
+    vector<uint32_t> orders;
+    for (const PendingOrder& o : m.pendingOrders()) orders.push_back(o.id);
+    for (uint32_t id : orders) m.cancelOrder(id);
+    m.calculateTotalAsset();
+    //아직 시작하지 않은 게임이면 시작 버튼처럼 첫 턴을 바로 진행 (거래는 그 뒤부터)
+    if (m.day() == 1 && !m.isOver()) m.nextTurn();
+
+    MarketPath path;
+    path.m_scenario = m.sharedScenario();
+    path.m_seed = m.seed();
+    path.m_companies = m.companyCount();
+    path.m_firstDay = m.day();
+    path.m_days = max(0, m.maxDay() - m.day() + 1);
+    path.m_startCash = m.totalAsset(); //이미 진행 중인 게임이면 보유 주식까지 현금으로 보고 시작
+    path.m_goal = m.goalAmount();
+    path.m_prices.reserve((size_t)(path.m_days + 1) * path.m_companies);
+    path.m_eventOffsets.reserve(path.m_days + 2);
+    path.m_eventOffsets.push_back(0);
+
+    vector<int> scratch;
+    for (int row = 0; ; row++) {
+        for (int c = 0; c < path.m_companies; c++) path.m_prices.push_back(m.price(c));
+        path.appendEvents(m, scratch);
+        if (m.isOver() || row == path.m_days) break;
+        m.nextTurn();
+    }
+    return path;
+}
+
+void MarketPath::appendEvents(const Market& market, vector<int>& scratch) {
+    const Scenario& scenario = *m_scenario;
+    for (const NewsItem& item : market.todayNewsItems()) {
+        if (item.event < 0) continue;
+        const int32_t impact = scenario.event(item.event).impact;
+        if (item.index >= 0) {
+            m_events.push_back({ item.event, item.index, impact });
+            continue;
+        }
+        //회사 이름이 없는 뉴스: 타겟 특징 중 하나라도 가진 회사 (타겟이 없으면 전체)
+        const IdSpan targets = scenario.eventTargets(item.event);
+        scratch.clear();
+        if (targets.empty()) {
+            for (int c = 0; c < m_companies; c++) scratch.push_back(c);
+        } else {
+            for (int f : targets) {
+                IdSpan list = scenario.featurePostings(f);
+                scratch.insert(scratch.end(), list.begin(), list.end());
+            }
+            sort(scratch.begin(), scratch.end());
+            scratch.erase(unique(scratch.begin(), scratch.end()), scratch.end());
+        }
+        for (int c : scratch) m_events.push_back({ item.event, c, impact });
+    }
+    m_eventOffsets.push_back((uint32_t)m_events.size());
+}
+
+const char* strategyName(Strategy strategy) {
+    switch (strategy) {
+    case Strategy::BuyAndHold: return "hold";
+    case Strategy::Momentum: return "momentum";
+    case Strategy::NewsReactive: return "news";
+    }
+    return "?";
+}
+
+string BotSpec::name() const {
+    char buf[96];
+    switch (strategy) {
+    case Strategy::BuyAndHold:
+        snprintf(buf, sizeof(buf), "hold k=%d #%08llx", picks, (unsigned long long)(seed & 0xffffffffu));
+        break;
+    case Strategy::Momentum:
+        snprintf(buf, sizeof(buf), "momentum L=%d k=%d", lookback, picks);
+        break;
+    case Strategy::NewsReactive:
+        snprintf(buf, sizeof(buf), "news T=%d H=%d k=%d", threshold, lookback, picks);
+        break;
+    }
+    return buf;
+}
+
+vector<BotSpec> makeBotGrid(int count, uint64_t seed) {
+    vector<BotSpec> bots;
+    bots.reserve(max(0, count));
+    for (int i = 0; i < count; i++) {
+        //봇마다 독립된 난수열로 파라미터를 뽑음 (봇 수를 바꿔도 앞쪽 봇은 그대로)
+        RandomStream rng(seed, RandomStream::Trader, 0xffffffffu, (uint32_t)i);
+        BotSpec bot;
+        bot.strategy = Strategy(i % 3);
+        bot.seed = (uint64_t(rng.next()) << 32) | rng.next();
+        bot.picks = rng.random_num(1, 10);
+        switch (bot.strategy) {
+        case Strategy::BuyAndHold:
+            break;
+        case Strategy::Momentum:
+            bot.lookback = rng.random_num(1, 10);
+            bot.picks = rng.random_num(1, 5);
+            break;
+        case Strategy::NewsReactive:
+            bot.threshold = rng.random_num(1, 15);
+            bot.lookback = rng.random_num(1, 10);
+            bot.picks = rng.random_num(1, 5);
+            break;
+        }
+        bots.push_back(bot);
+    }
+    return bots;
+}
+
+vector<BacktestResult> runBacktest(const MarketPath& path, const vector<BotSpec>& bots, ThreadPool* pool) {
+    //모멘텀 순위는 lookback마다 한 번만 계산
+    vector<MomentumRanks> ranks;
+    for (const BotSpec& bot : bots) {
+        if (bot.strategy != Strategy::Momentum) continue;
+        auto it = find_if(ranks.begin(), ranks.end(), [&](const MomentumRanks& r) { return r.lookback == bot.lookback; });
+        if (it == ranks.end()) { ranks.push_back({}); it = ranks.end() - 1; it->lookback = bot.lookback; }
+        it->width = max(it->width, min(bot.picks, path.companyCount()));
+    }
+    for (MomentumRanks& r : ranks) buildRanks(path, r, pool);
+
+    vector<BacktestResult> results(bots.size());
+    auto step = [&](size_t begin, size_t end) {
+        Trader trader(path);
+        BotScratch scratch;
+        for (size_t i = begin; i < end; i++) {
+            const BotSpec& bot = bots[i];
+            const MomentumRanks* rank = nullptr;
+            if (bot.strategy == Strategy::Momentum)
+                for (const MomentumRanks& r : ranks) if (r.lookback == bot.lookback) rank = &r;
+            runBot(path, bot, rank, trader, scratch);
+            const double asset = trader.value(scratch.portfolio, path.days());
+            results[i] = { (int)i, asset, scratch.portfolio.trades, asset >= path.goal() };
+        }
+    };
+    if (pool) pool->parallelFor(0, bots.size(), BotGrain, step);
+    else step(0, bots.size());
+
+    sort(results.begin(), results.end(), [](const BacktestResult& a, const BacktestResult& b) {
+        return a.finalAsset != b.finalAsset ? a.finalAsset > b.finalAsset : a.bot < b.bot;
+    });
+    return results;
+}
@@ -0,0 +1,90 @@
+﻿#ifndef BACKTEST_H
+#define BACKTEST_H
+
+#include "Market.h"
+
+class ThreadPool;
+
+// 전략 백테스트
+// 게임 하나를 거래 없이 끝까지 진행해서 날짜별 종가와 발생 이벤트(시장 경로)를 한 번만 만들고,
+// 수천 개의 봇이 그 경로를 읽기 전용으로 공유하며 각자 가벼운 포트폴리오(현금 + 보유량)로 거래합니다.
+// 봇은 가격을 움직이지 않는 가격 수용자이고, 체결은 그날의 시장 조성 호가(Market::makerLevels)를 훑어서
+// 게임과 같은 슬리피지와 현금 한도 규칙을 따릅니다. 결과는 스레드 수와 무관하게 항상 같습니다.
+
+//경로에 기록된 이벤트 영향 하나 (뉴스로 알 수 있는 대상 회사마다 하나씩)
+struct PathEvent {
+    int32_t event; //이벤트 인덱스
+    int32_t company; //대상 회사
+    int32_t impact; //이벤트 impact (%)
+};
+
+class MarketPath {
+public:
+    //market을 복사해서 게임이 끝날 때까지 진행합니다. (market은 그대로, 장중 모드는 끄고 진행)
+    //시작 전(1일차) 게임이면 게임 시작처럼 첫 턴을 먼저 진행하고, 행 0은 첫 거래 시점입니다.
+    //회사 이름이 없는 이벤트 뉴스는 플레이어처럼 타겟 특징을 가진 회사 전체를 대상으로 봅니다.
+    static MarketPath record(const Market& market);
+
+    //거래할 수 있는 날 수 (가격 행은 days() + 1개, 마지막 행은 최종 평가용)
+    int days() const { return m_days; }
+    int companyCount() const { return m_companies; }
+    int firstDay() const { return m_firstDay; } //행 0의 게임 날짜
+    uint64_t seed() const { return m_seed; }
+    double startCash() const { return m_startCash; }
+    double goal() const { return m_goal; }
+    const Scenario& scenario() const { return *m_scenario; }
+
+    //행 row의 회사별 종가 (행 0 = 시작 시점, 행 t = t번째 턴이 끝난 뒤)
+    const double* prices(int row) const { return m_prices.data() + (size_t)row * m_companies; }
+    //행 row에서 알 수 있는 이벤트 (그 행을 만든 턴에 발생한 것)
+    const PathEvent* eventsBegin(int row) const { return m_events.data() + m_eventOffsets[row]; }
+    const PathEvent* eventsEnd(int row) const { return m_events.data() + m_eventOffsets[row + 1]; }
+    size_t eventTotal() const { return m_events.size(); }
+
+private:
+    shared_ptr<const Scenario> m_scenario;
+    uint64_t m_seed = 0;
+    int m_days = 0;
+    int m_companies = 0;
+    int m_firstDay = 1;
+    double m_startCash = 0;
+    double m_goal = 0;
+    vector<double> m_prices; //(days + 1) × 회사
+    vector<PathEvent> m_events; //행 순서로 이어 붙임
+    vector<uint32_t> m_eventOffsets; //행별 시작 위치 (days + 2개)
+
+    void appendEvents(const Market& market, vector<int>& scratch);
+};
+
+enum class Strategy { BuyAndHold, Momentum, NewsReactive };
+
+//봇 하나의 설정
+//BuyAndHold: 첫날 picks개 종목(시드로 선택)에 균등 분배하고 끝까지 보유
+//Momentum: 매일 lookback일 수익률 상위 picks개(상승한 종목만)로 갈아탐
+//NewsReactive: impact가 threshold 이상인 이벤트 대상 종목을 사고, -threshold 이하면 팔고, lookback일 보유 후 정리
+struct BotSpec {
+    Strategy strategy = Strategy::BuyAndHold;
+    int lookback = 1;
+    int picks = 1;
+    int threshold = 5;
+    uint64_t seed = 0;
+
+    string name() const;
+};
+
+//전략별로 파라미터를 바꿔 가며 count개 봇을 만듭니다.
+vector<BotSpec> makeBotGrid(int count, uint64_t seed);
+
+struct BacktestResult {
+    int bot; //봇 인덱스 (bots 안의 위치)
+    double finalAsset;
+    int trades; //체결된 주문 수
+    bool reachedGoal;
+};
+
+//봇을 스레드 풀에서 나눠 돌리고 최종 자산 내림차순으로 정렬해서 돌려줍니다. (pool이 nullptr이면 단일 스레드)
+vector<BacktestResult> runBacktest(const MarketPath& path, const vector<BotSpec>& bots, ThreadPool* pool = nullptr);
+
+const char* strategyName(Strategy strategy);
+
+#endif // BACKTEST_H
@@ -0,0 +1,132 @@
+﻿// 전략 백테스트 러너
+// 시드 하나로 시장 경로를 한 번 만들고, 여러 전략/파라미터의 봇 수천 개를 같은 경로 위에서 병렬로 돌려
+// 최종 자산 순위와 전략별 요약(평균, 최고, 목표 달성률)을 출력합니다.
+//
+// 사용법: stockBacktest [--bots N] [--threads T] [--seed S] [--bot-seed S] [--top K] [--json out.json]
+//                      [--scenario file.json|file.sgsc]
+#include "Backtest.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+struct Options {
+    int bots = 10000;
+    unsigned threads = thread::hardware_concurrency();
+    uint64_t seed = 20240601; //시장 경로 시드 (게임 시드와 같음)
+    uint64_t botSeed = 1; //봇 파라미터 시드
+    int top = 20;
+    const char* jsonPath = nullptr;
+    const char* scenario = nullptr; //없으면 내장 기본 시나리오
+};
+
+bool parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        const char* v = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!strcmp(a, "--bots") && v) { opt.bots = atoi(v); i++; }
+        else if (!strcmp(a, "--threads") && v) { opt.threads = (unsigned)atoi(v); i++; }
+        else if (!strcmp(a, "--seed") && v) { opt.seed = strtoull(v, nullptr, 10); i++; }
+        else if (!strcmp(a, "--bot-seed") && v) { opt.botSeed = strtoull(v, nullptr, 10); i++; }
+        else if (!strcmp(a, "--top") && v) { opt.top = atoi(v); i++; }
+        else if (!strcmp(a, "--json") && v) { opt.jsonPath = v; i++; }
+        else if (!strcmp(a, "--scenario") && v) { opt.scenario = v; i++; }
+        else return false;
+    }
+    return opt.bots > 0 && opt.top >= 0;
+}
+
+//전략별 요약
+struct Summary {
+    int bots = 0;
+    int wins = 0;
+    double sum = 0;
+    double best = 0;
+};
+
+void writeJson(const char* path, const MarketPath& market, const vector<BotSpec>& bots,
+               const vector<BacktestResult>& results, const Options& opt) {
+    FILE* f = fopen(path, "w");
+    if (!f) { fprintf(stderr, "cannot write %s\n", path); return; }
+    fprintf(f, "{\n  \"seed\": %llu,\n  \"days\": %d,\n  \"companies\": %d,\n  \"goal\": %.0f,\n  \"startCash\": %.0f,\n"
+               "  \"ranking\": [\n", (unsigned long long)opt.seed, market.days(), market.companyCount(),
+            market.goal(), market.startCash());
+    for (size_t i = 0; i < results.size(); i++) {
+        const BacktestResult& r = results[i];
+        fprintf(f, "    {\"rank\": %zu, \"bot\": %d, \"name\": \"%s\", \"strategy\": \"%s\", \"finalAsset\": %.0f, "
+                   "\"goalRatio\": %.4f, \"trades\": %d, \"reachedGoal\": %s}%s\n",
+                i + 1, r.bot, bots[r.bot].name().c_str(), strategyName(bots[r.bot].strategy), r.finalAsset,
+                r.finalAsset / market.goal(), r.trades, r.reachedGoal ? "true" : "false",
+                (i + 1 < results.size()) ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+}
+
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        fprintf(stderr, "usage: %s [--bots N] [--threads T] [--seed S] [--bot-seed S] [--top K] [--json out.json]"
+                        " [--scenario file]\n", argv[0]);
+        return 1;
+    }
+
+    shared_ptr<const Scenario> scenario = Scenario::builtin();
+    if (opt.scenario) {
+        string error;
+        scenario = Scenario::load(opt.scenario, &error);
+        if (!scenario) { fprintf(stderr, "%s\n", error.c_str()); return 1; }
+    }
+
+    auto start = chrono::steady_clock::now();
+    const MarketPath path = MarketPath::record(Market(scenario, opt.seed));
+    const double recordTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    const vector<BotSpec> bots = makeBotGrid(opt.bots, opt.botSeed);
+    start = chrono::steady_clock::now();
+    vector<BacktestResult> results;
+    {
+        ThreadPool pool(opt.threads);
+        results = runBacktest(path, bots, &pool);
+    }
+    const double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    printf("market     : seed %llu, %d companies, %d trading days, %zu event hits (recorded in %.3f s)\n",
+           (unsigned long long)opt.seed, path.companyCount(), path.days(), path.eventTotal(), recordTime);
+    printf("bots       : %d (%u threads, bot seed %llu)\n", opt.bots, opt.threads, (unsigned long long)opt.botSeed);
+    printf("elapsed    : %.3f s (%.0f bots/s)\n", elapsed, opt.bots / max(elapsed, 1e-9));
+    printf("goal       : %.0f (start %.0f)\n", path.goal(), path.startCash());
+
+    printf("\n%5s  %-28s %14s %8s %7s\n", "rank", "bot", "final asset", "x goal", "trades");
+    const int shown = min(opt.top, (int)results.size());
+    for (int i = 0; i < shown; i++) {
+        const BacktestResult& r = results[i];
+        printf("%5d  %-28s %14.0f %8.3f %7d%s\n", i + 1, bots[r.bot].name().c_str(), r.finalAsset,
+               r.finalAsset / path.goal(), r.trades, r.reachedGoal ? "  *" : "");
+    }
+
+    Summary summary[3];
+    for (const BacktestResult& r : results) {
+        Summary& s = summary[(int)bots[r.bot].strategy];
+        if (s.bots == 0 || r.finalAsset > s.best) s.best = r.finalAsset;
+        s.bots++;
+        s.sum += r.finalAsset;
+        if (r.reachedGoal) s.wins++;
+    }
+    printf("\n%-10s %7s %14s %14s %9s\n", "strategy", "bots", "mean", "best", "goal hit");
+    for (int k = 0; k < 3; k++) {
+        const Summary& s = summary[k];
+        if (s.bots == 0) continue;
+        printf("%-10s %7d %14.0f %14.0f %8.2f%%\n", strategyName(Strategy(k)), s.bots, s.sum / s.bots, s.best,
+               100.0 * s.wins / s.bots);
+    }
+
+    if (opt.jsonPath) writeJson(opt.jsonPath, path, bots, results, opt);
+    return 0;
+}
@@ -0,0 +1,214 @@
+﻿// 밸런스 검증용 몬테카를로 러너
+// 30일 게임을 수백만 판 돌려 목표 달성률, 최종 자산 분포, 이벤트 발생 빈도를 출력합니다.
+//
+// 사용법: stockBalance [--games N] [--threads T] [--seed S] [--chunk C] [--strategy hold|random|momentum]
+//                     [--scenario file.json|file.sgsc]
+// 시나리오 파일을 고치고 다시 컴파일하지 않고 바로 돌려볼 수 있습니다.
+#include "Market.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+namespace {
+
+enum class Strategy { Hold, Random, Momentum };
+
+struct Options {
+    long long games = 1000000;
+    unsigned threads = thread::hardware_concurrency();
+    uint64_t seed = 20240601;
+    long long chunk = 4096;
+    Strategy strategy = Strategy::Momentum;
+    const char* scenario = nullptr; //없으면 내장 기본 시나리오
+};
+
+//작업(청크) 하나의 집계 결과
+struct Tally {
+    long long wins = 0;
+    vector<long long> eventFires; //이벤트별 총 발생 횟수
+    vector<long long> eventGames; //이벤트가 한 번 이상 발생한 게임 수
+};
+
+void sellAll(Market& m) {
+    for (int i = 0; i < m.companyCount(); i++) {
+        int owned = m.owned(i);
+        if (owned > 0) m.sellStock(i, owned);
+    }
+}
+
+void buyMax(Market& m, int index) {
+    double price = m.price(index);
+    if (price <= 0) return;
+    int amount = (int)(m.cash() / price);
+    if (amount > 0) m.buyStock(index, amount);
+}
+
+//하루 거래: 플레이어가 정산 화면을 닫고 다음 날로 넘어가기 전에 하는 행동
+void trade(Market& m, Strategy strategy) {
+    switch (strategy) {
+    case Strategy::Hold:
+        //첫날 현금을 전 종목에 균등 분배하고 끝까지 보유
+        if (m.day() == 2) {
+            double share = m.cash() / m.companyCount();
+            for (int i = 0; i < m.companyCount(); i++) {
+                int amount = (int)(share / m.price(i));
+                if (amount > 0) m.buyStock(i, amount);
+            }
+        }
+        break;
+    case Strategy::Random:
+        sellAll(m);
+        buyMax(m, RandomStream(m.seed(), RandomStream::Trader, m.day(), 0).random_num(0, m.companyCount() - 1));
+        break;
+    case Strategy::Momentum: {
+        //전날 상승률이 가장 높은 종목에 전액 투자
+        sellAll(m);
+        int best = 0;
+        for (int i = 1; i < m.companyCount(); i++)
+            if (m.changeRate(i) > m.changeRate(best)) best = i;
+        buyMax(m, best);
+        break;
+    }
+    }
+}
+
+bool parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        const char* v = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!strcmp(a, "--games") && v) { opt.games = atoll(v); i++; }
+        else if (!strcmp(a, "--threads") && v) { opt.threads = (unsigned)atoi(v); i++; }
+        else if (!strcmp(a, "--seed") && v) { opt.seed = strtoull(v, nullptr, 10); i++; }
+        else if (!strcmp(a, "--chunk") && v) { opt.chunk = atoll(v); i++; }
+        else if (!strcmp(a, "--scenario") && v) { opt.scenario = v; i++; }
+        else if (!strcmp(a, "--strategy") && v) {
+            if (!strcmp(v, "hold")) opt.strategy = Strategy::Hold;
+            else if (!strcmp(v, "random")) opt.strategy = Strategy::Random;
+            else if (!strcmp(v, "momentum")) opt.strategy = Strategy::Momentum;
+            else return false;
+            i++;
+        }
+        else return false;
+    }
+    return opt.games > 0 && opt.chunk > 0;
+}
+
+double percentile(vector<double>& sorted, double p) {
+    size_t idx = (size_t)std::llround(p * (sorted.size() - 1));
+    return sorted[idx];
+}
+
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        fprintf(stderr, "usage: %s [--games N] [--threads T] [--seed S] [--chunk C] [--strategy hold|random|momentum]"
+                        " [--scenario file]\n", argv[0]);
+        return 1;
+    }
+
+    shared_ptr<const Scenario> scenario = Scenario::builtin();
+    if (opt.scenario) {
+        string error;
+        scenario = Scenario::load(opt.scenario, &error);
+        if (!scenario) { fprintf(stderr, "%s\n", error.c_str()); return 1; }
+    }
+
+    //시나리오 데이터는 모든 게임이 공유하고, 작업마다 시작 상태만 복사해서 독립된 시장으로 사용
+    const Market prototype(scenario, opt.seed);
+    const size_t eventCount = prototype.eventCount();
+
+    vector<double> finalAssets((size_t)opt.games);
+    Tally total;
+    total.eventFires.assign(eventCount, 0);
+    total.eventGames.assign(eventCount, 0);
+    mutex totalMutex;
+
+    auto start = chrono::steady_clock::now();
+    {
+        ThreadPool pool(opt.threads);
+        for (long long lo = 0; lo < opt.games; lo += opt.chunk) {
+            long long hi = min(opt.games, lo + opt.chunk);
+            pool.submit([&, lo, hi] {
+                Tally local;
+                local.eventFires.assign(eventCount, 0);
+                local.eventGames.assign(eventCount, 0);
+                vector<char> firedThisGame(eventCount);
+
+                for (long long g = lo; g < hi; g++) {
+                    uint64_t gameSeed = opt.seed + (uint64_t)g;
+                    Market m = prototype;
+                    m.reseed(gameSeed);
+                    fill(firedThisGame.begin(), firedThisGame.end(), 0);
+
+                    //게임 시작 버튼과 동일하게 첫 턴은 바로 진행
+                    while (true) {
+                        m.nextTurn();
+                        for (int e : m.firedEvents()) { local.eventFires[e]++; firedThisGame[e] = 1; }
+                        if (m.isOver()) break;
+                        trade(m, opt.strategy);
+                    }
+
+                    finalAssets[(size_t)g] = m.totalAsset();
+                    if (m.isVictory()) local.wins++;
+                    for (size_t e = 0; e < eventCount; e++) local.eventGames[e] += firedThisGame[e];
+                }
+
+                lock_guard<mutex> lock(totalMutex);
+                total.wins += local.wins;
+                for (size_t e = 0; e < eventCount; e++) {
+                    total.eventFires[e] += local.eventFires[e];
+                    total.eventGames[e] += local.eventGames[e];
+                }
+            });
+        }
+        pool.wait();
+    }
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    //결과 출력
+    const double games = (double)opt.games;
+    const double goal = prototype.goalAmount();
+    double sum = 0, sumSq = 0;
+    for (double v : finalAssets) { sum += v; sumSq += v * v; }
+    double mean = sum / games;
+    double stddev = sqrt(max(0.0, sumSq / games - mean * mean));
+    sort(finalAssets.begin(), finalAssets.end());
+
+    static const char* strategyNames[] = { "hold", "random", "momentum" };
+    printf("games      : %lld (%s, %u threads, seed %llu)\n", opt.games, strategyNames[(int)opt.strategy],
+           opt.threads, (unsigned long long)opt.seed);
+    printf("elapsed    : %.3f s (%.0f games/s)\n", elapsed, games / elapsed);
+    printf("win rate   : %.3f%% (goal %.0f)\n", 100.0 * total.wins / games, goal);
+    printf("final asset: mean %.0f, stddev %.0f\n", mean, stddev);
+    printf("             min %.0f, p5 %.0f, p25 %.0f, p50 %.0f, p75 %.0f, p95 %.0f, max %.0f\n",
+           finalAssets.front(), percentile(finalAssets, 0.05), percentile(finalAssets, 0.25),
+           percentile(finalAssets, 0.50), percentile(finalAssets, 0.75), percentile(finalAssets, 0.95),
+           finalAssets.back());
+
+    //목표 대비 비율 히스토그램 (0.25배 단위, 마지막 칸은 2배 이상)
+    printf("\nfinal asset / goal:\n");
+    const int buckets = 9;
+    vector<long long> hist(buckets, 0);
+    for (double v : finalAssets) hist[min(buckets - 1, max(0, (int)(v / goal / 0.25)))]++;
+    for (int b = 0; b < buckets; b++) {
+        double pct = 100.0 * hist[b] / games;
+        if (b == buckets - 1) printf("  >= %.2f   ", b * 0.25);
+        else printf("  %.2f-%.2f ", b * 0.25, (b + 1) * 0.25);
+        printf("%7.3f%% %s\n", pct, string((size_t)(pct / 2), '#').c_str());
+    }
+
+    printf("\nevent frequency (fires per game, games with >= 1 fire):\n");
+    for (size_t e = 0; e < eventCount; e++) {
+        string name(prototype.eventName((int)e));
+        printf("  %-32s %6.3f %7.3f%%\n", name.c_str(),
+               total.eventFires[e] / games, 100.0 * total.eventGames[e] / games);
+    }
+    return 0;
+}
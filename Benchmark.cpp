@@ -0,0 +1,295 @@
+﻿// 턴 파이프라인 마이크로 벤치마크
+// 기본 시장(initData)과 합성 시장(회사 1k/10k/100k, 이벤트 100/1k, 긴 기록, 장중 390틱)에서
+// nextTurn과 각 단계(UpdateEffects, ProcessEvents, CalculatePrices 등)를 따로 측정합니다.
+// Qt가 있으면 stockList()/getStockHistory()도 측정합니다.
+// 주문장은 무작위 주문 흐름(지정가/시장가/취소)을 넣어 주문 하나당 처리 시간을 잽니다.
+//
+// 사용법: stockBench [--json out.json] [--turns N] [--max-companies N] [--filter 이름] [--trace trace.json]
+// --trace는 STOCKGAME_PROFILE 빌드에서 전체 턴 측정 구간의 단계별 트레이스를 Chrome 트레이스 JSON으로 저장합니다.
+#include "Market.h"
+#include "OrderBook.h"
+#include "PriceKernel.h"
+#include "Profiler.h"
+#include "Synthetic.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+
+#ifdef STOCKGAME_BENCH_QT
+#include "GameBackend.h"
+#endif
+
+namespace {
+
+struct Options {
+    const char* jsonPath = nullptr;
+    int turns = 200;
+    int maxCompanies = 100000;
+    const char* filter = nullptr;
+    const char* tracePath = nullptr;
+};
+
+struct Universe {
+    string name;
+    function<Market()> make;
+    int warmupDays; //측정 전에 미리 진행할 날 수 (기록 길이)
+};
+
+struct Result {
+    string universe;
+    int companies;
+    int events;
+    size_t historyDays;
+    size_t historyBytes; //회사 하나의 종가 기록이 차지하는 메모리
+    string benchmark;
+    int iterations;
+    double minNs;
+    double medianNs;
+    double meanNs;
+};
+
+using Clock = chrono::steady_clock;
+
+double elapsedNs(Clock::time_point start) {
+    return chrono::duration<double, nano>(Clock::now() - start).count();
+}
+
+Result summarize(const string& universe, const Market& m, const string& benchmark, vector<double>& samples) {
+    sort(samples.begin(), samples.end());
+    double sum = 0;
+    for (double v : samples) sum += v;
+    return { universe, m.companyCount(), m.eventCount(), m.history(0).size(), m.history(0).memoryBytes(), benchmark,
+             (int)samples.size(), samples.front(), samples[samples.size() / 2], sum / samples.size() };
+}
+
+//기록 길이를 늘리기 위해 주가 계산만 반복 (이벤트/뉴스는 생략)
+void warmup(Market& m, int days) {
+    for (int d = 0; d < days; d++) m.CalculatePrices();
+}
+
+void runUniverse(const Universe& u, const Options& opt, vector<Result>& results, Profiler* profiler) {
+    Market base = u.make();
+    if (base.companyCount() > opt.maxCompanies) return;
+    warmup(base, u.warmupDays);
+
+    const int companies = base.companyCount();
+    const int iterations = max(10, min(opt.turns, 2000000 / max(1, companies)));
+
+    //단계별: 같은 시장에서 하루씩 진행하며 단계마다 따로 잼
+    {
+        Market m = base;
+        vector<double> tick, update, events, prices, total;
+        for (int t = 0; t < iterations; t++) {
+            auto s = Clock::now(); m.TickCooldowns(); tick.push_back(elapsedNs(s));
+            s = Clock::now(); m.UpdateEffects(); update.push_back(elapsedNs(s));
+            s = Clock::now(); m.ProcessEvents(); events.push_back(elapsedNs(s));
+            s = Clock::now(); m.CalculatePrices(); prices.push_back(elapsedNs(s));
+            s = Clock::now(); m.calculateTotalAsset(); total.push_back(elapsedNs(s));
+        }
+        results.push_back(summarize(u.name, base, "TickCooldowns", tick));
+        results.push_back(summarize(u.name, base, "UpdateEffects", update));
+        results.push_back(summarize(u.name, base, "ProcessEvents", events));
+        results.push_back(summarize(u.name, base, "CalculatePrices", prices));
+        results.push_back(summarize(u.name, base, "calculateTotalAsset", total));
+    }
+
+    //전체 턴
+    {
+        Market m = base;
+        m.setProfiler(profiler);
+        vector<double> samples;
+        for (int t = 0; t < iterations && !m.isOver(); t++) {
+            auto s = Clock::now(); m.nextTurn(); samples.push_back(elapsedNs(s));
+        }
+        if (!samples.empty()) results.push_back(summarize(u.name, base, "nextTurn", samples));
+    }
+
+#ifdef STOCKGAME_BENCH_QT
+    //QML에 넘기는 변환 비용
+    {
+        GameBackend backend(base);
+        const int qtIterations = max(5, min(opt.turns, 200000 / max(1, companies)));
+        vector<double> list, history;
+        for (int t = 0; t < qtIterations; t++) {
+            auto s = Clock::now();
+            QVariantList snapshot = backend.stockList();
+            list.push_back(elapsedNs(s));
+            (void)snapshot;
+
+            int index = (int)((t * 2654435761u) % (unsigned)companies);
+            s = Clock::now();
+            QVariantList series = backend.getStockHistory(index);
+            history.push_back(elapsedNs(s));
+            (void)series;
+        }
+        results.push_back(summarize(u.name, base, "stockList", list));
+        results.push_back(summarize(u.name, base, "getStockHistory", history));
+    }
+#endif
+}
+
+//자동 매매 주문 흐름: 지정가 45% (중간가 ±30호가), 시장가 30%, 취소 25%
+struct SimOrder {
+    enum Kind : uint8_t { Limit, Market, Cancel } kind;
+    OrderBook::Side side;
+    int64_t price;
+    int64_t quantity;
+    uint32_t pick; //취소할 주문 선택용
+};
+
+vector<SimOrder> makeOrderFlow(size_t count, uint64_t seed) {
+    constexpr int64_t Mid = 100000, Step = 10;
+    vector<SimOrder> flow(count);
+    RandomStream rng(seed, RandomStream::Trader, 0, 0);
+    for (SimOrder& o : flow) {
+        int roll = rng.random_num(1, 100);
+        o.kind = roll <= 45 ? SimOrder::Limit : (roll <= 75 ? SimOrder::Market : SimOrder::Cancel);
+        o.side = rng.roll(50) ? OrderBook::Buy : OrderBook::Sell;
+        //매수는 중간가 아래쪽, 매도는 위쪽에 주로 걸되 일부는 반대편과 겹쳐 바로 체결됨
+        int offset = rng.random_num(-5, 30);
+        o.price = Mid + (o.side == OrderBook::Buy ? -offset : offset) * Step;
+        o.quantity = rng.random_num(1, 100);
+        o.pick = rng.next();
+    }
+    return flow;
+}
+
+void runOrderBook(const Options& opt, vector<Result>& results) {
+    constexpr size_t Batch = 100000;
+    const int batches = max(5, min(opt.turns, 50));
+    const vector<SimOrder> flow = makeOrderFlow(Batch * batches, 1);
+
+    OrderBook book;
+    vector<OrderBook::OrderId> resting;
+    int64_t filled = 0;
+    auto onFill = [&](const OrderBook::Fill& f) { filled += f.quantity; };
+    vector<double> samples;
+    for (int b = 0; b < batches; b++) {
+        auto s = Clock::now();
+        for (size_t i = b * Batch; i < (b + 1) * Batch; i++) {
+            const SimOrder& o = flow[i];
+            if (o.kind == SimOrder::Limit) {
+                OrderBook::Result r = book.submitLimit(o.side, o.price, o.quantity, 1, onFill);
+                if (r.resting != OrderBook::NoOrder) resting.push_back(r.resting);
+            } else if (o.kind == SimOrder::Market) {
+                book.submitMarket(o.side, o.quantity, onFill);
+            } else if (!resting.empty()) {
+                //이미 체결된 주문이면 취소가 실패할 뿐 (실제 매매와 같음)
+                size_t k = o.pick % resting.size();
+                book.cancel(resting[k]);
+                resting[k] = resting.back();
+                resting.pop_back();
+            }
+        }
+        samples.push_back(elapsedNs(s) / Batch);
+    }
+    sort(samples.begin(), samples.end());
+    double sum = 0;
+    for (double v : samples) sum += v;
+    results.push_back({ "orderbook", 1, 0, 0, 0, "order", (int)samples.size(), samples.front(),
+                        samples[samples.size() / 2], sum / samples.size() });
+    printf("%-24s %-20s n=%-5d median %12.1f ns  min %12.1f ns  (%.1f M orders/s, %zu resting, %lld filled)\n",
+           "orderbook", "order", (int)samples.size(), samples[samples.size() / 2], samples.front(),
+           1e3 / samples[samples.size() / 2], book.orderCount(), (long long)filled);
+}
+
+void writeJson(const char* path, const vector<Result>& results) {
+    FILE* f = fopen(path, "w");
+    if (!f) { fprintf(stderr, "cannot write %s\n", path); return; }
+    fprintf(f, "{\n  \"kernel\": \"%s\",\n  \"results\": [\n", priceKernelName());
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        fprintf(f, "    {\"universe\": \"%s\", \"companies\": %d, \"events\": %d, \"historyDays\": %zu, "
+                   "\"historyBytes\": %zu, \"benchmark\": \"%s\", \"iterations\": %d, \"minNs\": %.1f, \"medianNs\": %.1f, \"meanNs\": %.1f}%s\n",
+                r.universe.c_str(), r.companies, r.events, r.historyDays, r.historyBytes, r.benchmark.c_str(), r.iterations,
+                r.minNs, r.medianNs, r.meanNs, (i + 1 < results.size()) ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+}
+
+bool parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        const char* v = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!strcmp(a, "--json") && v) { opt.jsonPath = v; i++; }
+        else if (!strcmp(a, "--turns") && v) { opt.turns = atoi(v); i++; }
+        else if (!strcmp(a, "--max-companies") && v) { opt.maxCompanies = atoi(v); i++; }
+        else if (!strcmp(a, "--filter") && v) { opt.filter = v; i++; }
+        else if (!strcmp(a, "--trace") && v) { opt.tracePath = v; i++; }
+        else return false;
+    }
+    return opt.turns > 0;
+}
+
+Universe synthetic(const string& name, int companies, int events, int warmupDays, int intradayTicks = 0,
+                   unsigned indicators = 0) {
+    return { name, [companies, events, intradayTicks, indicators] {
+        SyntheticSpec spec;
+        spec.companies = companies;
+        spec.events = events;
+        Market m = makeSyntheticMarket(spec);
+        IntradayConfig intraday;
+        intraday.ticks = intradayTicks;
+        m.setIntraday(intraday);
+        IndicatorConfig config;
+        config.enabled = indicators;
+        m.setIndicators(config);
+        return m;
+    }, warmupDays };
+}
+
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        fprintf(stderr, "usage: %s [--json out.json] [--turns N] [--max-companies N] [--filter name] [--trace out.json]\n",
+                argv[0]);
+        return 1;
+    }
+
+    const vector<Universe> universes = {
+        { "default", [] { return Market(1); }, 0 },
+        synthetic("synth-1k-100ev", 1000, 100, 0),
+        synthetic("synth-10k-100ev", 10000, 100, 0),
+        synthetic("synth-100k-100ev", 100000, 100, 0),
+        synthetic("synth-10k-1kev", 10000, 1000, 0),
+        synthetic("synth-1k-100ev-hist10k", 1000, 100, 10000),
+        synthetic("synth-1k-100ev-tick390", 1000, 100, 0, 390),
+        synthetic("synth-10k-100ev-tick390", 10000, 100, 0, 390),
+        synthetic("synth-10k-100ev-ind", 10000, 100, 0, 0, IndicatorConfig::All),
+        synthetic("synth-1k-100ev-hist10k-ind", 1000, 100, 10000, 0, IndicatorConfig::All),
+        synthetic("synth-100-10ev-hist100k", 100, 10, 100000),
+    };
+
+    if (opt.tracePath && !Profiler::compiledIn())
+        fprintf(stderr, "warning: built without STOCKGAME_PROFILE, trace will be empty\n");
+    Profiler profiler;
+    Profiler* tracer = opt.tracePath ? &profiler : nullptr;
+
+    vector<Result> results;
+    for (const auto& u : universes) {
+        if (opt.filter && u.name.find(opt.filter) == string::npos) continue;
+        size_t before = results.size();
+        runUniverse(u, opt, results, tracer);
+        for (size_t i = before; i < results.size(); i++) {
+            const Result& r = results[i];
+            printf("%-24s %-20s n=%-5d median %12.0f ns  min %12.0f ns  (%.2f ns/company)\n",
+                   r.universe.c_str(), r.benchmark.c_str(), r.iterations, r.medianNs, r.minNs,
+                   r.medianNs / max(1, r.companies));
+        }
+    }
+    if (!opt.filter || string("orderbook").find(opt.filter) != string::npos) runOrderBook(opt, results);
+    printf("price kernel: %s\n", priceKernelName());
+
+    if (opt.jsonPath) writeJson(opt.jsonPath, results);
+    if (tracer) {
+        string error;
+        if (!profiler.writeChromeTrace(opt.tracePath, &error)) { fprintf(stderr, "%s\n", error.c_str()); return 1; }
+    }
+    return 0;
+}
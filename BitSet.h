@@ -0,0 +1,26 @@
+﻿#ifndef BITSET_H
+#define BITSET_H
+
+#include <cstdint>
+
+// 고정 길이 워드 배열 비트셋 도우미
+// 회사/이벤트별 비트셋을 하나의 평탄한 vector<uint64_t>에 words 간격으로 저장해 두고 사용합니다.
+// 반복문이 단순해서 컴파일러가 SIMD로 자동 벡터화할 수 있습니다.
+namespace bits {
+
+inline int wordsFor(int count) { return (count + 63) / 64; }
+
+inline void set(uint64_t* words, int bit) { words[bit >> 6] |= (uint64_t(1) << (bit & 63)); }
+inline void clear(uint64_t* words, int bit) { words[bit >> 6] &= ~(uint64_t(1) << (bit & 63)); }
+inline bool test(const uint64_t* words, int bit) { return (words[bit >> 6] >> (bit & 63)) & 1; }
+
+//두 비트셋에 공통 비트가 하나라도 있는지
+inline bool intersects(const uint64_t* a, const uint64_t* b, int words) {
+    uint64_t acc = 0;
+    for (int i = 0; i < words; i++) acc |= (a[i] & b[i]);
+    return acc != 0;
+}
+
+}
+
+#endif // BITSET_H
@@ -0,0 +1,524 @@
+﻿// 결정적 자체 검사
+// 주문장 체결 규칙, 증분 지표, 압축 종가 기록, 스레드 풀처럼 눈으로 확인하기 어려운 코어 로직을 고정된 입력으로 돌려
+// 기대값(또는 처음부터 다시 계산한 값)과 비교합니다.
+// 실패한 검사마다 파일:줄과 조건을 출력하고, 하나라도 실패하면 1로 끝납니다. (ctest에 구역별로 등록됨)
+//
+// 사용법: stockCheck [구역 ...]   (없으면 전부, 구역: orderbook, indicators, history, threadpool)
+#include "Downsampler.h"
+#include "Indicators.h"
+#include "Market.h"
+#include "OrderBook.h"
+#include "PriceHistory.h"
+#include "SaveGame.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+
+namespace {
+
+int g_failures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); g_failures++; } \
+    } while (0)
+
+//체결 기록 (onFill 콜백용)
+struct Fills {
+    vector<OrderBook::Fill> list;
+    void operator()(const OrderBook::Fill& f) { list.push_back(f); }
+};
+
+void checkOrderBook() {
+    //같은 가격은 들어온 순서대로, 마지막 주문은 일부만 체결
+    {
+        OrderBook book;
+        const OrderBook::OrderId a = book.rest(OrderBook::Sell, 100, 5, 1);
+        const OrderBook::OrderId b = book.rest(OrderBook::Sell, 100, 5, 2);
+        const OrderBook::OrderId c = book.rest(OrderBook::Sell, 100, 5, 3);
+        Fills fills;
+        const OrderBook::Result r = book.submitMarket(OrderBook::Buy, 12, fills);
+        CHECK(r.filled == 12 && r.cost == 1200 && r.lastPrice == 100 && r.resting == OrderBook::NoOrder);
+        CHECK(fills.list.size() == 3);
+        if (fills.list.size() == 3) {
+            CHECK(fills.list[0].maker == a && fills.list[0].makerOwner == 1 && fills.list[0].quantity == 5 && fills.list[0].makerDone);
+            CHECK(fills.list[1].maker == b && fills.list[1].makerOwner == 2 && fills.list[1].quantity == 5 && fills.list[1].makerDone);
+            CHECK(fills.list[2].maker == c && fills.list[2].makerOwner == 3 && fills.list[2].quantity == 2 && !fills.list[2].makerDone);
+        }
+        CHECK(book.remaining(a) == 0 && book.remaining(b) == 0 && book.remaining(c) == 3);
+        CHECK(book.orderCount() == 1 && book.levels(OrderBook::Sell).size() == 1);
+        CHECK(book.levels(OrderBook::Sell).back().quantity == 3);
+    }
+
+    //가격 우선: 한도 안의 좋은 호가부터 체결하고 남은 수량은 주문장에 올림
+    {
+        OrderBook book;
+        book.rest(OrderBook::Sell, 101, 4, 1);
+        book.rest(OrderBook::Sell, 99, 3, 2);
+        book.rest(OrderBook::Sell, 98, 2, 3);
+        Fills fills;
+        const OrderBook::Result r = book.submitLimit(OrderBook::Buy, 100, 10, 9, fills);
+        CHECK(r.filled == 5 && r.cost == 2 * 98 + 3 * 99 && r.lastPrice == 99);
+        CHECK(fills.list.size() == 2 && fills.list[0].price == 98 && fills.list[1].price == 99);
+        CHECK(r.resting != OrderBook::NoOrder && book.remaining(r.resting) == 5);
+        CHECK(book.bestBid() == 100 && book.bestAsk() == 101);
+
+        //반대쪽 시장가 매도는 최우선 매수호가부터
+        Fills sells;
+        book.rest(OrderBook::Buy, 95, 10, 4);
+        const OrderBook::Result s = book.submitMarket(OrderBook::Sell, 7, sells);
+        CHECK(s.filled == 7 && s.cost == 5 * 100 + 2 * 95);
+        CHECK(sells.list.size() == 2 && sells.list[0].makerOwner == 9 && sells.list[1].makerOwner == 4);
+        CHECK(book.remaining(r.resting) == 0 && book.bestBid() == 95);
+
+        //가격이 맞지 않는 지정가는 체결 없이 올라감
+        Fills none;
+        const OrderBook::Result t = book.submitLimit(OrderBook::Sell, 102, 1, 5, none);
+        CHECK(t.filled == 0 && none.list.empty() && book.remaining(t.resting) == 1);
+    }
+
+    //예산 한도: 살 수 있는 만큼만 사고 나머지는 버림
+    {
+        OrderBook book;
+        book.rest(OrderBook::Sell, 100, 5, 1);
+        book.rest(OrderBook::Sell, 110, 5, 2);
+        Fills fills;
+        const OrderBook::Result r = book.submitMarket(OrderBook::Buy, 10, fills, 1000);
+        CHECK(r.filled == 9 && r.cost == 5 * 100 + 4 * 110 && r.cost <= 1000);
+        CHECK(fills.list.size() == 2 && fills.list[1].quantity == 4 && !fills.list[1].makerDone);
+        CHECK(book.levels(OrderBook::Sell).size() == 1 && book.levels(OrderBook::Sell).back().quantity == 1);
+
+        //한 주도 살 수 없으면 체결 없음
+        Fills poor;
+        const OrderBook::Result p = book.submitMarket(OrderBook::Buy, 1, poor, 109);
+        CHECK(p.filled == 0 && poor.list.empty() && book.bestAsk() == 110);
+    }
+
+    //취소: 남은 수량을 돌려주고, 노드를 재사용해도 예전 번호로는 찾을 수 없음
+    {
+        OrderBook book;
+        const OrderBook::OrderId a = book.rest(OrderBook::Buy, 50, 8, 1);
+        const OrderBook::OrderId b = book.rest(OrderBook::Buy, 50, 2, 2);
+        int64_t left = 0;
+        CHECK(book.cancel(a, &left) && left == 8);
+        CHECK(!book.cancel(a) && book.remaining(a) == 0);
+        const OrderBook::OrderId c = book.rest(OrderBook::Buy, 50, 3, 3);
+        CHECK(uint32_t(c) == uint32_t(a) && c != a); //같은 노드, 다른 세대
+        CHECK(!book.cancel(a) && book.remaining(c) == 3);
+
+        //취소 후에도 같은 가격의 순서는 유지 (b가 c보다 먼저)
+        Fills fills;
+        book.submitMarket(OrderBook::Sell, 4, fills);
+        CHECK(fills.list.size() == 2 && fills.list[0].maker == b && fills.list[1].maker == c);
+        CHECK(book.remaining(c) == 1 && book.orderCount() == 1);
+
+        //체결로 빠진 주문도 취소할 수 없음
+        CHECK(!book.cancel(b));
+        CHECK(book.cancel(c) && book.empty() && book.orderCount() == 0);
+        CHECK(book.rest(OrderBook::Buy, 0, 1, 1) == OrderBook::NoOrder && book.rest(OrderBook::Buy, 1, 0, 1) == OrderBook::NoOrder);
+    }
+}
+
+//종가 전체로 지표를 처음부터 다시 계산 (IndicatorEngine과 같은 정의, 창을 매번 새로 훑음)
+IndicatorValues bruteIndicators(const vector<double>& closes, const IndicatorConfig& config) {
+    IndicatorValues v;
+    const size_t n = closes.size();
+    if (n == 0) return v;
+    const size_t smaFrom = n - min(n, (size_t)config.smaWindow);
+    double sum = 0;
+    for (size_t i = smaFrom; i < n; i++) sum += closes[i];
+    v.sma = sum / (n - smaFrom);
+
+    const double alpha = 2.0 / (config.emaPeriod + 1);
+    v.ema = closes[0];
+    for (size_t i = 1; i < n; i++) v.ema += alpha * (closes[i] - v.ema);
+
+    vector<double> returns;
+    for (size_t i = 1; i < n; i++) returns.push_back(closes[i - 1] > 0 ? closes[i] / closes[i - 1] - 1.0 : 0.0);
+    const size_t volFrom = returns.size() - min(returns.size(), (size_t)config.volatilityWindow);
+    const size_t count = returns.size() - volFrom;
+    if (count > 1) {
+        double mean = 0, m2 = 0;
+        for (size_t i = volFrom; i < returns.size(); i++) mean += returns[i];
+        mean /= count;
+        for (size_t i = volFrom; i < returns.size(); i++) m2 += (returns[i] - mean) * (returns[i] - mean);
+        v.volatility = sqrt(m2 / (count - 1)) * 100.0;
+    }
+
+    //와일더: 처음 기간은 단순 평균, 그 뒤로 (이전 × (기간 - 1) + 새 값) / 기간
+    const size_t period = (size_t)config.rsiPeriod;
+    double gain = 0, loss = 0, gainSum = 0, lossSum = 0;
+    for (size_t i = 1; i < n; i++) {
+        const double change = closes[i] - closes[i - 1];
+        const double g = max(change, 0.0), l = max(-change, 0.0);
+        if (i <= period) {
+            gainSum += g;
+            lossSum += l;
+            gain = gainSum / i;
+            loss = lossSum / i;
+        } else {
+            gain = (gain * (period - 1) + g) / period;
+            loss = (loss * (period - 1) + l) / period;
+        }
+    }
+    if (n > 1) v.rsi = (gain + loss > 0) ? 100.0 * gain / (gain + loss) : 50.0;
+
+    double peak = 0;
+    for (size_t i = 0; i < n; i++) {
+        peak = max(peak, closes[i]);
+        v.drawdown = peak > 0 ? (closes[i] / peak - 1.0) * 100.0 : 0.0;
+        v.maxDrawdown = min(v.maxDrawdown, v.drawdown);
+    }
+    return v;
+}
+
+bool near(double a, double b) { return fabs(a - b) <= 1e-9 * max(1.0, fabs(b)); }
+
+bool sameIndicators(const IndicatorValues& a, const IndicatorValues& b) {
+    return near(a.sma, b.sma) && near(a.ema, b.ema) && near(a.volatility, b.volatility) && near(a.rsi, b.rsi) &&
+           near(a.drawdown, b.drawdown) && near(a.maxDrawdown, b.maxDrawdown);
+}
+
+void checkIndicators() {
+    //엔진 직접: 무작위 종가를 붙이고, 중간중간 오늘 가격을 여러 번 고침 (창이 차기 전/후 모두)
+    {
+        IndicatorConfig config;
+        config.enabled = IndicatorConfig::All;
+        config.smaWindow = 5;
+        config.emaPeriod = 10;
+        config.volatilityWindow = 7;
+        config.rsiPeriod = 4;
+        IndicatorEngine engine;
+        engine.configure(config, vector<PriceHistory>(1));
+        mt19937_64 rng(7);
+        uniform_real_distribution<double> step(-0.05, 0.05);
+        vector<double> closes;
+        PriceHistory history;
+        double price = 1000;
+        int mismatches = 0;
+        for (int day = 0; day < 400; day++) {
+            price *= 1.0 + step(rng);
+            if (day % 37 == 5) price = closes.empty() ? price : closes.back(); //변화 없는 날
+            closes.push_back(price);
+            history.push(price);
+            engine.push(0, price);
+            mismatches += !sameIndicators(engine.values(0), bruteIndicators(closes, config));
+            for (int k = 0; k < (day % 3); k++) {
+                closes.back() = price * (1.0 + step(rng));
+                history.setBack(closes.back());
+                engine.revise(0, closes.back());
+                mismatches += !sameIndicators(engine.values(0), bruteIndicators(closes, config));
+            }
+            price = closes.back();
+        }
+        CHECK(mismatches == 0);
+        CHECK(engine.smaSeries(0).size() == closes.size() && engine.emaSeries(0).size() == closes.size());
+        CHECK(near(engine.smaSeries(0).back(), engine.values(0).sma) && near(engine.emaSeries(0).back(), engine.values(0).ema));
+
+        //기록에서 다시 쌓아도 같은 값
+        IndicatorEngine rebuilt;
+        rebuilt.configure(config, vector<PriceHistory>{ history });
+        CHECK(sameIndicators(rebuilt.values(0), engine.values(0)));
+    }
+
+    //시장: 거래 체결로 오늘 가격이 바뀌는 경로(applyTradePrice → revise)까지 기록 전체와 비교
+    {
+        Market m(20240601);
+        IndicatorConfig config;
+        config.enabled = IndicatorConfig::All;
+        m.setIndicators(config);
+        mt19937_64 rng(11);
+        int mismatches = 0;
+        vector<double> closes;
+        auto compareAll = [&] {
+            for (int i = 0; i < m.companyCount(); i++) {
+                closes.clear();
+                m.history(i).copy(0, m.history(i).size(), closes);
+                mismatches += !sameIndicators(m.indicatorValues(i), bruteIndicators(closes, m.indicators()));
+            }
+        };
+        for (int day = 0; day < 25 && !m.isOver(); day++) {
+            compareAll();
+            for (int t = 0; t < 4; t++) {
+                const int company = (int)(rng() % (uint64_t)m.companyCount());
+                if (rng() % 2) m.buyStock(company, 1 + (int)(rng() % 20));
+                else m.sellStock(company, 1 + (int)(rng() % 20));
+                compareAll();
+            }
+            m.nextTurn();
+        }
+        compareAll();
+        CHECK(mismatches == 0);
+    }
+
+    //복원: 저장한 적 없는 시장과 스냅샷+저널로 되살린 시장(스냅샷 없는 경우 포함)의 지표가 같아야 함
+    {
+        IndicatorConfig config;
+        config.enabled = IndicatorConfig::All;
+        Market m(20240602);
+        m.setIndicators(config);
+        const string journalPath = "stockCheck_resume.sgjn", snapshotPath = "stockCheck_resume.sgsv";
+        JournalWriter journal;
+        CHECK(journal.create(journalPath, m.seed(), m.scenario().fingerprint()));
+        mt19937_64 rng(13);
+        for (int day = 0; day < 30 && !m.isOver(); day++) {
+            for (int t = 0; t < 3; t++) {
+                const int company = (int)(rng() % (uint64_t)m.companyCount());
+                const int amount = 1 + (int)(rng() % 20);
+                if (rng() % 2) { if (m.buyStock(company, amount)) journal.buy(company, amount); }
+                else if (m.sellStock(company, amount)) journal.sell(company, amount);
+            }
+            m.nextTurn();
+            journal.turn(m);
+            if (day == 14) {
+                vector<char> snapshot;
+                m.saveSnapshot(snapshot, journal.count());
+                CHECK(writeFileAtomic(snapshotPath, snapshot));
+            }
+        }
+        journal.close();
+
+        auto resumesSame = [&](const string& snapshot) {
+            Market resumed(m.sharedScenario(), 1);
+            resumed.setIndicators(config);
+            uint64_t records = 0;
+            string error;
+            if (!resumeGame(m.sharedScenario(), snapshot, journalPath, resumed, &records, &error)) {
+                fprintf(stderr, "resume failed: %s\n", error.c_str());
+                return false;
+            }
+            if (!(resumed.indicators() == m.indicators()) || resumed.day() != m.day()) return false;
+            for (int i = 0; i < m.companyCount(); i++)
+                if (!sameIndicators(resumed.indicatorValues(i), m.indicatorValues(i))) return false;
+            return true;
+        };
+        CHECK(resumesSame(snapshotPath));
+        CHECK(resumesSame(snapshotPath + ".missing"));
+        remove(journalPath.c_str());
+        remove(snapshotPath.c_str());
+    }
+}
+
+//[begin, end) 구간의 봉 (처음부터 다시 계산)
+MinMaxDownsampler::Bucket bruteBucket(const vector<double>& values, size_t begin, size_t end) {
+    MinMaxDownsampler::Bucket b{ values[begin], values[begin], values[begin], values[end - 1] };
+    for (size_t i = begin; i < end; i++) {
+        b.min = min(b.min, values[i]);
+        b.max = max(b.max, values[i]);
+    }
+    return b;
+}
+
+bool sameBucket(const MinMaxDownsampler::Bucket& a, const MinMaxDownsampler::Bucket& b) {
+    return a.min == b.min && a.max == b.max && a.first == b.first && a.last == b.last;
+}
+
+//봉 구간이 값 [0, count)를 span씩 나눈 것과 같은지
+bool bucketsMatch(const MinMaxDownsampler& d, const vector<double>& values, size_t count) {
+    if (d.count() != count || d.buckets().size() != (count + d.span() - 1) / d.span()) return false;
+    for (size_t b = 0; b < d.buckets().size(); b++) {
+        if (!sameBucket(d.buckets()[b], bruteBucket(values, b * d.span(), min(count, (b + 1) * d.span())))) return false;
+    }
+    return true;
+}
+
+//history 전체를 값 목록과 비교: 원본 구간은 비트까지 같고, 봉 구간은 묶인 날들의 봉과 같아야 함
+bool historyMatches(const PriceHistory& h, const vector<double>& values) {
+    if (h.size() != values.size() || h.back() != values.back()) return false;
+    const size_t exact = h.exactBegin();
+    if (!bucketsMatch(h.rollup(), values, exact)) return false;
+    for (size_t d = exact; d < values.size(); d++) {
+        const double v = h.at(d);
+        if (memcmp(&v, &values[d], sizeof v) != 0) return false;
+    }
+    //visit: 날 수 합계가 맞고, 원본 구간은 하루씩, 봉 구간은 봉 그대로
+    size_t day = 0;
+    bool ok = true;
+    h.visit(0, h.size(), [&](const PriceHistory::Bucket& b, size_t days) {
+        if (day < exact) {
+            const size_t span = h.rollup().span();
+            ok &= sameBucket(b, h.rollup().buckets()[day / span]) && day / span == (day + days - 1) / span;
+        } else {
+            ok &= days == 1 && b.last == values[day] && b.min == values[day];
+        }
+        day += days;
+    });
+    if (!ok || day != values.size()) return false;
+    //copy는 구간 중간부터 시작해도 at()과 같음
+    vector<double> copied;
+    const size_t from = values.size() / 3;
+    h.copy(from, values.size(), copied);
+    if (copied.size() != values.size() - from) return false;
+    for (size_t i = 0; i < copied.size(); i++) {
+        if (copied[i] != h.at(from + i)) return false;
+    }
+    return true;
+}
+
+//저장/복원을 흉내 내서 같은 상태가 되는지
+bool restoresSame(const PriceHistory& h, const vector<double>& values) {
+    vector<double> exact;
+    h.copy(h.exactBegin(), h.size(), exact);
+    PriceHistory back(h.config());
+    const MinMaxDownsampler& r = h.rollup();
+    return back.restore(r.buckets().data(), r.buckets().size(), r.span(), r.count(), exact.data(), exact.size()) &&
+           historyMatches(back, values) && back.exactBegin() == h.exactBegin();
+}
+
+void checkHistory() {
+    //다운샘플러: 구간 합치기와 복원 검사
+    {
+        vector<double> values;
+        mt19937_64 rng(3);
+        MinMaxDownsampler d(8);
+        bool ok = true;
+        for (int i = 0; i < 1000; i++) {
+            values.push_back((double)(rng() % 1000));
+            d.append(values.back());
+            ok &= d.buckets().size() <= 8 && bucketsMatch(d, values, values.size());
+        }
+        CHECK(ok);
+        MinMaxDownsampler back(8);
+        CHECK(back.restore(d.buckets().data(), d.buckets().size(), d.span(), d.count()) && bucketsMatch(back, values, values.size()));
+        CHECK(!back.restore(d.buckets().data(), d.buckets().size(), d.span() * 3, d.count())); //2의 거듭제곱 아님
+        CHECK(!back.restore(d.buckets().data(), d.buckets().size(), d.span(), d.count() + d.span())); //날 수가 구간보다 많음
+        vector<MinMaxDownsampler::Bucket> broken = d.buckets();
+        broken[1].last = broken[1].max + 1;
+        CHECK(!back.restore(broken.data(), broken.size(), d.span(), d.count()));
+        broken[1] = { NAN, NAN, NAN, NAN };
+        CHECK(!back.restore(broken.data(), broken.size(), d.span(), d.count()));
+    }
+
+    //기본 설정: 링(256일) → 압축 청크(128일 × 8) → 봉 경계 전후를 모두 확인
+    {
+        PriceHistory h;
+        vector<double> values;
+        mt19937_64 rng(5);
+        uniform_real_distribution<double> step(-0.03, 0.03);
+        double price = 50000;
+        int mismatches = 0, restoreMismatches = 0;
+        const size_t checkpoints[] = { 1, 2, 255, 256, 257, 383, 384, 385, 1279, 1280, 1281, 1408, 1409, 5000, 20000 };
+        size_t next = 0;
+        for (size_t day = 0; day < 20000; day++) {
+            //같은 값이 이어지는 날, 정수 가격, 임의 변화가 섞이도록 (XOR 인코딩의 세 경우)
+            if (day % 11 == 0) price = round(price);
+            else if (day % 7 != 0) price *= 1.0 + step(rng);
+            values.push_back(price);
+            h.push(price);
+            if (day % 13 == 0) { //오늘 가격 고치기 (거래 체결)
+                values.back() = price = price + 1;
+                h.setBack(price);
+            }
+            if (next < size(checkpoints) && values.size() == checkpoints[next]) {
+                next++;
+                mismatches += !historyMatches(h, values);
+                restoreMismatches += !restoresSame(h, values);
+            }
+        }
+        CHECK(next == size(checkpoints));
+        CHECK(mismatches == 0);
+        CHECK(restoreMismatches == 0);
+        CHECK(h.memoryBytes() < 32 * 1024); //20000일이어도 회사당 수십 KB 이하
+
+        //원본 구간 경계: 1280일까지는 전부 원본, 그 뒤로 가장 오래된 청크가 봉으로
+        PriceHistory edge;
+        for (int d = 0; d < 1280; d++) edge.push(d + 0.5);
+        CHECK(edge.exactBegin() == 0 && edge.at(0) == 0.5 && edge.at(255) == 255.5 && edge.at(1279) == 1279.5);
+        edge.push(1280.5);
+        CHECK(edge.exactBegin() == 128 && edge.rollup().count() == 128 && edge.at(128) == 128.5);
+    }
+
+    //작은 설정으로 봉 합치기를 자주 일으켜서 매일 비교 (압축 청크 없이 바로 봉으로 가는 경우 포함)
+    for (int maxChunks : { 0, 1, 3 }) {
+        HistoryConfig config;
+        config.recentDays = 3;
+        config.chunkDays = 5;
+        config.maxChunks = maxChunks;
+        config.rollupBars = 4;
+        PriceHistory h(config);
+        vector<double> values;
+        int mismatches = 0;
+        for (int day = 0; day < 600; day++) {
+            values.push_back(1000.0 + (day * 37 % 101) - (day % 9 == 0 ? 0.25 : 0.0));
+            h.push(values.back());
+            mismatches += !historyMatches(h, values);
+            if (day % 50 == 0) mismatches += !restoresSame(h, values);
+        }
+        CHECK(mismatches == 0);
+        CHECK(h.rollup().buckets().size() <= 4);
+    }
+}
+
+void checkThreadPool() {
+    //작은 parallelFor를 연달아: 마지막 조각이 래치를 건드리는 중에 호출자가 돌아가 버리면 여기서 깨짐
+    //(스택의 래치가 같은 자리에 다시 생기므로 ASan/TSan 빌드에서 특히 잘 드러남)
+    ThreadPool pool(4);
+    atomic<long long> sum{0};
+    long long expected = 0;
+    for (int call = 0; call < 20000; call++) {
+        const size_t n = 2 + call % 7;
+        pool.parallelFor(0, n, 1, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; i++) sum.fetch_add((long long)i, memory_order_relaxed);
+        });
+        expected += (long long)(n * (n - 1) / 2);
+        if (sum.load() != expected) break; //반환했으면 모든 조각이 끝났어야 함
+    }
+    CHECK(sum.load() == expected);
+
+    //작업 안에서 다시 parallelFor (워커가 자기 조각을 기다리며 막히면 안 됨)
+    sum = 0;
+    for (int call = 0; call < 500; call++) {
+        pool.parallelFor(0, 8, 1, [&](size_t, size_t) {
+            pool.parallelFor(0, 16, 4, [&](size_t lo, size_t hi) { sum.fetch_add((long long)(hi - lo), memory_order_relaxed); });
+        });
+    }
+    CHECK(sum.load() == 500LL * 8 * 16);
+
+    //바깥 스레드 여러 개가 동시에
+    sum = 0;
+    vector<thread> callers;
+    for (int t = 0; t < 3; t++) {
+        callers.emplace_back([&] {
+            for (int call = 0; call < 2000; call++)
+                pool.parallelFor(0, 64, 8, [&](size_t lo, size_t hi) { sum.fetch_add((long long)(hi - lo), memory_order_relaxed); });
+        });
+    }
+    for (auto& t : callers) t.join();
+    CHECK(sum.load() == 3LL * 2000 * 64);
+}
+
+struct Section {
+    const char* name;
+    void (*run)();
+};
+
+const Section Sections[] = {
+    { "orderbook", checkOrderBook },
+    { "indicators", checkIndicators },
+    { "history", checkHistory },
+    { "threadpool", checkThreadPool },
+};
+
+}
+
+int main(int argc, char** argv) {
+    for (const Section& s : Sections) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; i++) selected |= !strcmp(argv[i], s.name);
+        if (!selected) continue;
+        const int before = g_failures;
+        s.run();
+        printf("%-12s %s\n", s.name, g_failures == before ? "ok" : "FAILED");
+    }
+    for (int i = 1; i < argc; i++) {
+        bool known = false;
+        for (const Section& s : Sections) known |= !strcmp(argv[i], s.name);
+        if (!known) { fprintf(stderr, "unknown section: %s\n", argv[i]); return 1; }
+    }
+    return g_failures ? 1 : 0;
+}
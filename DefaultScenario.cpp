@@ -0,0 +1,93 @@
+﻿#include "Scenario.h"
+
+//기본 시나리오 (scenarios/default.json과 같은 내용)
+//시나리오 파일 없이 실행하는 도구(밸런스 러너, 벤치마크)와 파일을 찾지 못했을 때의 앱에서 사용합니다.
+//내용을 바꾸면 default.json도 함께 갱신: stockScenario --dump-default scenarios/default.json
+ScenarioSource defaultScenarioSource() {
+    ScenarioSource s;
+    s.startCash = 1200000;
+    s.goal = 4000000;
+    s.lastDay = 30;
+
+    s.companies = {
+        {"에어니온", 98000.0, {"가전제품", "대기업", "제조업", "수출"},
+         "에어니온은 냉장고·세탁기·에어컨을 포함한 다양한 가전제품을 생산하는 글로벌 제조 대기업으로, 내수 시장은 물론 해외 수출에서도 강한 존재감을 보여주고 있습니다."},
+        {"홈렉스", 88000.0, {"가전제품", "대기업", "제조업"},
+         "홈렉스는 생활 가전에 특화된 대기업으로, 중저가형 가전 제품군에서 높은 시장 점유율을 보유하고 있으며 탄탄한 제조 기반을 바탕으로 국내 소비자들에게 널리 사랑받고 있습니다."},
+        {"스틸포지", 63000.0, {"철강", "대기업", "제조업", "수출"},
+         "스틸포지는 국내 철강 산업을 대표하는 기업으로, 산업용 강판과 특수 강재를 중심으로 제품을 생산하며 해외 조선·건설 업체들과의 꾸준한 계약을 통해 수출 비중이 높습니다."},
+        {"그린팜푸드", 24000.0, {"식료품", "중견기업"},
+         "그린팜푸드는 신선식품·가공식품을 주력으로 하는 중견 식품 기업으로, 안전성과 품질 관리에 강점을 지녀 꾸준한 소비층을 확보하고 있습니다."},
+        {"오토드라이브", 112000.0, {"자동차", "대기업", "제조업"},
+         "오토드라이브는 세단·SUV·전기차 등 다양한 라인업을 보유한 자동차 제조 대기업으로, 혁신적인 기술과 안정성으로 국내 시장에서 높은 신뢰도를 자랑합니다."},
+        {"파워모터스", 96000.0, {"자동차", "대기업", "수출", "제조업"},
+         "파워모터스는 스포츠카와 고성능 차량군에서 강세를 가진 자동차 수출 대기업으로, 해외 모터스포츠 시장에서도 기술력을 인정받으며 글로벌 인지도를 높여가고 있습니다."},
+        {"퓨처소프트", 145000.0, {"소프트웨어", "대기업"},
+         "퓨처소프트는 클라우드·AI·보안 솔루션을 중심으로 성장한 IT 대기업으로, 대규모 기업용 소프트웨어 시장에서 선도적인 위치를 차지하고 있습니다."},
+        {"넥트론", 36000.0, {"소프트웨어", "중견기업"},
+         "넥트론은 모바일 앱·게임·사내 솔루션 등 다양한 소프트웨어를 개발하는 중견 기업으로, 민첩한 개발력과 신기술 적용으로 꾸준히 성장세를 이어가고 있습니다."}
+    };
+
+
+    s.effects = {
+        {"해외시장 진출", +4, 12}, {"유행", +3, 5}, {"신제품 개발 성공", +5, 7}, {"신규 공장 완성", +5, 10},
+        {"정부의 산업 지원 발표", +5, 10}, {"대규모 투자 유치", +4, 8}, {"신규 기술 특허 획득", +4, 6},
+        {"경쟁사 제품 문제 발생", +3, 6}, {"핵심 파트너십 체결", +3, 7}, {"유명 인플루언서 홍보", +2, 4},
+        {"해외 규제 완화 혜택", +4, 10}, {"대형 계약 수주", +5, 8}, {"브랜드 이미지 상승", +2, 6}, {"시장 점유율 증가", +3, 7},
+
+        {"파업", -4, 4}, {"인력 이탈", -3, 5}, {"주요 자원 수급 불안", -4, 6}, {"안정성 문제 제기", -4, 5},
+        {"정부 규제 강화", -3, 10}, {"경쟁사 신제품 출시", -3, 6}, {"주요 고객사 계약 종료", -3, 8},
+        {"안전 문제 발생", -3, 7}, {"부정적 여론 확산", -2, 5}, {"경영진 교체 불안감", -2, 5},
+        {"원자재 가격 급등", -3, 8}, {"환율 악재", -2, 6}, {"해외 규제 리스크", -3, 7}
+    };
+
+
+    s.events = {//일부 뉴스문장 수정, 즉시 양수 버프값 약간 증가, 소프트웨어 회사에게 악영향을 줄수있는 이벤트 2개 추가
+                 {"해외시장 진출", true, false, +9, {}, {{"해외시장 진출"}}, 3, 0, "<company>, 해외시장 신규 진출 성공… 해외 수요 증가 기대", 20},
+                 {"신제품 히트", true, false, +11, {"가전제품","자동차","소프트웨어"}, {{"유행"}}, 3, 0, "<company>, 신제품 판매 급증… 관련 업계 주목", 15},
+                 {"정부 지원금 수혜", false, false, +7, {"중견기업"}, {{"정부의 산업 지원 발표"}}, 3, 0, "정부, 중견기업 대상 산업 지원금 발표… 대상 기업 주가 상승 기대", 10},
+                 {"주요 계약 체결", true, false, +9, {"제조업","자동차","소프트웨어"}, {{"대형 계약 수주"}}, 3, 0, "<company>, 주요 기업과 대형 계약 체결 성공", 12},
+                 {"대규모 해외 계약", true, false, +22, {"대기업","수출"}, {{"대형 계약 수주"}}, 5, 0, "<company>, 해외 대규모 수출 계약 체결… 주가 강세", 5},
+                 {"트렌드 급상승", false, false, +6, {"소프트웨어","가전제품","식료품"}, {{"유행"}}, 3, 0, "올해 소비 트렌드 변화로 해당 업종(가전·식품·소프트웨어) 기업 매출 기대감 증가", 8},
+                 {"국제 전시회 성공", true, false, +11, {"가전제품","자동차","수출"}, {{"해외시장 진출"}}, 3, 0, "<company>, 국제 전시회에서 해외 구매자 관심 집중", 7},
+                 {"글로벌 파트너십 체결", true, false, +13, {"소프트웨어","제조업"}, {{"핵심 파트너십 체결"}}, 3, 0, "<company>, 해외 유력 기업과 전략적 파트너십 체결", 6},
+                 {"유명 인플루언서 협업", true, false, +6, {"식료품","가전제품"}, {{"유명 인플루언서 홍보"}}, 3, 0, "<company>, 유명 인플루언서 협업으로 제품 관심도 급증", 9},
+                 {"규제 완화 혜택", false, false, +7, {"수출","제조업"}, {{"해외 규제 완화 혜택"}}, 3, 0, "정부, 수출·제조 업계 대상 해외 규제 완화 발표… 관련 기업 수혜 기대", 7},
+                 {"브랜드 이미지 개선", true, false, +6, {}, {{"브랜드 이미지 상승"}}, 3, 0, "<company>, 브랜드 이미지 상승… 소비자 선호도 증가", 8},
+                 {"시장 점유율 확대", true, false, +7, {"식료품","가전제품","자동차"}, {{"시장 점유율 증가"}}, 3, 0, "<company>, 시장 점유율 확대로 성장세 이어가", 6},
+                 {"대규모 투자 유치 성공", true, false, +15, {"대기업","수출","자동차"}, {{"대규모 투자 유치"}}, 5, 0, "<company>, 해외 투자사로부터 대규모 자금 유치 성공", 5},
+                 {"신기술 특허 취득", true, false, +15, {"소프트웨어","가전제품","제조업"}, {{"신규 기술 특허 획득"}}, 5, 0, "<company>, 차세대 핵심 기술 특허 취득", 8},
+                 {"신규 공장 준공", true, false, +11, {"제조업"}, {{"신규 공장 완성"}}, 5, 0, "<company>, 신규 생산 공장 완공… 생산능력 확대 기대", 7},
+                 {"생산 라인 화재", true, true, -18, {"제조업"}, {{"안전 문제 발생"}}, 5, 0, "<company>, 생산 라인 화재로 공정 차질", 5},
+                 {"리콜 사태", true, true, -10, {"자동차","가전제품"}, {{"안정성 문제 제기"}}, 5, 0, "<company>, 제품 리콜 사태 발생… 신뢰도 하락", 7},
+                 {"해외 수출 규제", false, false, -8, {"수출"}, {{"해외 규제 리스크"}}, 3, 0, "해외 규제 강화로 수출 업계 타격… 관련 기업 우려 증가", 5},
+                 {"사이버 보안 사고", true, true, -6, {"소프트웨어"}, {}, 3, 0, "<company>, 보안 사고 발생… 서비스 신뢰성 논란", 8},
+                 {"자연재해 피해", true, true, -20, {"제조업","식료품","자동차"}, {}, 5, 0, "<company>, 자연재해로 생산시설 피해 발생", 3},
+                 {"경영진 스캔들", true, true, -5, {}, {{"경영진 교체 불안감"}}, 5, 0, "<company>, 경영진 스캔들로 투자자 불안", 5},
+                 {"원자재 가격 폭등", false, true, -5, {"제조업","자동차","철강"}, {{"원자재 가격 급등"}}, 3, 0, "원자재 가격 급등으로 제조·철강 업계 비용 부담 증가", 6},
+                 {"전국 파업 확산", false, true, -5, {"제조업","철강","자동차"}, {{"파업"}}, 3, 0, "전국 파업 확산으로 제조·철강·자동차 업종 생산 차질 우려", 7},
+                 {"핵심 인력 대거 이탈", true, true, -4, {"소프트웨어","제조업"}, {{"인력 이탈"}}, 3, 0, "<company>, 핵심 인력 대거 이탈로 프로젝트 차질 우려", 6},
+                 {"자원 공급 불안정", false, true, -5, {"철강","제조업"}, {{"주요 자원 수급 불안"}}, 3, 0, "자원 공급 불안정으로 철강·제조 업계 전반에 공급 차질 우려", 4},
+                 {"품질 논란 발생", true, true, -5, {"가전제품","식료품"}, {{"안정성 문제 제기"}}, 3, 0, "<company>, 품질 논란 발생… 소비자 신뢰 하락", 5},
+                 {"부정 여론 확산", true, true, -3, {}, {{"부정적 여론 확산"}}, 3, 0, "<company> 관련 부정 여론 확산… 이미지 타격", 9},
+                 {"경영진 교체 요구", true, true, -3, {"대기업","중견기업"}, {{"경영진 교체 불안감"}}, 3, 0, "<company>, 경영진 교체 요구 증가… 조직 안정성 우려", 6},
+                 {"환율 급변 악재", false, true, -3, {"수출","대기업"}, {{"환율 악재"}}, 3, 0, "환율 급등세 영향으로 수출·대기업 업종 부담 증가", 10},
+                 {"경쟁사 신제품 출시", false, true, -4, {"가전제품","자동차","소프트웨어"}, {{"경쟁사 신제품 출시"}}, 3, 0, "경쟁사 혁신 신제품 공개… 해당 업종 경쟁 심화", 6},
+                 {"주요 고객사 계약 종료", true, true, -6, {"제조업","자동차","가전제품"}, {{"주요 고객사 계약 종료"}}, 3, 0, "<company>, 주요 고객사와의 계약 종료… 매출 감소 우려", 5},
+                 {"서버 장애 발생", true, false, -7, {"소프트웨어"}, {}, 6, 0, "<company>, 장기간 서버 장애로 서비스 불안정… 이용자 불만 확산", 6},
+                 {"특허 소송 제기", true, false, -6, {"소프트웨어", "중견기업"}, {}, 7, 0, "<company>, 경쟁사로부터 특허 침해 소송 제기… 리스크 확대", 5},
+                 };
+    s.news = {
+        "서울 도심에서 경미한 교통사고 발생.", "부산 해변에서 지역 축제 성황리 개최.", "강원도 일대 소규모 정전 발생, 10분 만에 복구.",
+        "서울 한강변에서 반려견 산책 인구 급증.", "지하철역에서 분실물 접수량 증가.", "도심 카페 신규 메뉴 출시로 화제.",
+        "시민단체, 환경정화 캠페인 진행.", "비오는 날씨로 우산 대여 서비스 이용 증가.", "지역 마트에서 장바구니 할인 행사 개최.",
+        "공원에서 야외 음악 공연 열려 시민들 발걸음 이어져.", "주말에 주요 고속도로 정체 예상.", "도심 곳곳에서 길고양이 급식소 설치.",
+        "서울 시내 버스 노선 일시적으로 변경.", "지역 농산물 직거래 장터 오픈.", "시청 앞 분수대에서 어린이 물놀이 인기.",
+        "도서관에 신규 도서 대량 입고.", "시민들, 주말 등산객 증가로 산책로 붐벼.", "도심 공원 벚꽃 개화 시작.",
+        "야구 경기에서 극적 역전승이 화제.", "새로운 길거리 먹거리 트럭 등장.", "소규모 아파트 단지에서 정전 소동.",
+        "인근 초등학교에서 학예회 개최.", "골목길 벽화 마을 SNS에서 인기 급상승.", "마을 주민센터에서 건강검진 행사 열려.",
+        "지역 시장에서 반값 세일 진행.", "도심 카페에서 반려동물 동반 가능해져 인기.", "시민들, 주말 비 예보로 우비 구매 증가.",
+        "도심 곳곳에 주차 단속 강화 실시.", "하천 산책로에서 드문 철새 포착돼 화제.", "꽁꽁 얼어붙은 한강위로 고양이가 지나갑니다"
+    };
+    return s;
+}
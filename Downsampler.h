@@ -0,0 +1,114 @@
+﻿#ifndef DOWNSAMPLER_H
+#define DOWNSAMPLER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+using namespace std;
+
+// 차트용 최소/최대 다운샘플러
+// 데이터를 최대 capacity개(= 화면 가로 픽셀 수)의 구간으로 묶고 구간마다 최소/최대/처음/마지막 값을 유지합니다.
+// 구간이 capacity를 넘으면 이웃 구간 둘을 합쳐 구간 폭(span)을 2배로 늘리므로,
+// append는 분할 상환 O(1)이고 그릴 점 개수는 데이터 길이와 무관하게 capacity 이하입니다.
+// 구간은 곧 OHLC(first/max/min/last)라서 봉(캔들)을 넣어도 같은 방식으로 합쳐집니다.
+class MinMaxDownsampler {
+public:
+    struct Bucket {
+        double min;
+        double max;
+        double first;
+        double last;
+    };
+
+    explicit MinMaxDownsampler(size_t capacity = 512) { setCapacity(capacity); }
+
+    void setCapacity(size_t capacity) {
+        m_capacity = max<size_t>(2, capacity);
+        clear();
+    }
+    size_t capacity() const { return m_capacity; }
+
+    void clear() {
+        m_buckets.clear();
+        m_span = 1;
+        m_count = 0;
+    }
+
+    void assign(const double* data, size_t count) {
+        clear();
+        for (size_t i = 0; i < count; i++) append(data[i]);
+    }
+
+    void append(double v) { append(Bucket{v, v, v, v}); }
+
+    //봉 하나 추가 (min=저가, max=고가, first=시가, last=종가)
+    void append(const Bucket& bar) {
+        size_t lastFill = m_count - (m_buckets.empty() ? 0 : (m_buckets.size() - 1) * m_span);
+        if (m_buckets.empty() || lastFill >= m_span) {
+            m_buckets.push_back(bar);
+            if (m_buckets.size() > m_capacity) mergePairs();
+        } else {
+            Bucket& b = m_buckets.back();
+            b.min = min(b.min, bar.min);
+            b.max = max(b.max, bar.max);
+            b.last = bar.last;
+        }
+        m_count++;
+    }
+
+    //저장해 둔 구간을 그대로 되돌림 (구간 수/폭/데이터 수가 서로 맞지 않거나 구간 값이 어긋나면 false)
+    bool restore(const Bucket* buckets, size_t n, size_t span, size_t count) {
+        if (n > m_capacity || span == 0 || (span & (span - 1)) != 0) return false;
+        if (n == 0 ? count != 0 : (count <= (n - 1) * span || count > n * span)) return false;
+        for (size_t i = 0; i < n; i++) {
+            const Bucket& b = buckets[i];
+            //NaN도 여기서 걸러짐
+            if (!(b.min <= b.first && b.first <= b.max && b.min <= b.last && b.last <= b.max)) return false;
+        }
+        m_buckets.assign(buckets, buckets + n);
+        m_span = span;
+        m_count = count;
+        return true;
+    }
+
+    const vector<Bucket>& buckets() const { return m_buckets; }
+    size_t span() const { return m_span; } //구간 하나가 묶는 데이터 수
+    size_t count() const { return m_count; } //지금까지 넣은 데이터 수
+
+    //전체 최소/최대 (구간 수에 비례, 데이터 길이와 무관)
+    double minValue() const {
+        double v = m_buckets.empty() ? 0.0 : m_buckets[0].min;
+        for (const auto& b : m_buckets) v = min(v, b.min);
+        return v;
+    }
+    double maxValue() const {
+        double v = m_buckets.empty() ? 0.0 : m_buckets[0].max;
+        for (const auto& b : m_buckets) v = max(v, b.max);
+        return v;
+    }
+
+private:
+    vector<Bucket> m_buckets;
+    size_t m_capacity = 512;
+    size_t m_span = 1;
+    size_t m_count = 0;
+
+    void mergePairs() {
+        size_t out = 0;
+        for (size_t i = 0; i < m_buckets.size(); i += 2) {
+            Bucket b = m_buckets[i];
+            if (i + 1 < m_buckets.size()) {
+                const Bucket& n = m_buckets[i + 1];
+                b.min = min(b.min, n.min);
+                b.max = max(b.max, n.max);
+                b.last = n.last;
+            }
+            m_buckets[out++] = b;
+        }
+        m_buckets.resize(out);
+        m_span *= 2;
+    }
+};
+
+#endif // DOWNSAMPLER_H
@@ -0,0 +1,464 @@
+﻿#include "GameServer.h"
+#include "Json.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace {
+
+constexpr size_t ReadChunk = 64 * 1024;
+constexpr size_t OutputHighWater = 1 << 20; //응답이 이만큼 밀리면 읽기를 멈춤 (느린 클라이언트)
+constexpr int MaxEvents = 256;
+
+//공백으로 나눈 앞 max개 토큰 (개수 반환, 더 있으면 max + 1)
+int split(string_view line, string_view* tokens, int max) {
+    int n = 0;
+    size_t i = 0;
+    while (i < line.size()) {
+        while (i < line.size() && (line[i] == ' ' || line[i] == '\t')) i++;
+        if (i == line.size()) break;
+        size_t j = i;
+        while (j < line.size() && line[j] != ' ' && line[j] != '\t') j++;
+        if (n == max) return max + 1;
+        tokens[n++] = line.substr(i, j - i);
+        i = j;
+    }
+    return n;
+}
+
+template <typename T>
+bool parseNumber(string_view s, T& out) {
+    auto [end, ec] = from_chars(s.data(), s.data() + s.size(), out);
+    return ec == errc() && end == s.data() + s.size();
+}
+
+void appendNumber(string& out, double v) {
+    char buf[32];
+    out.append(buf, (size_t)snprintf(buf, sizeof buf, "%.17g", v));
+}
+
+void appendNumber(string& out, long long v) {
+    char buf[24];
+    out.append(buf, (size_t)snprintf(buf, sizeof buf, "%lld", v));
+}
+
+void appendError(string& out, const char* why) {
+    out += "{\"ok\":false,\"error\":";
+    appendJsonString(out, why);
+    out += "}\n";
+}
+
+void writeEvent(int fd) {
+    const uint64_t one = 1;
+    ssize_t n = write(fd, &one, sizeof one);
+    (void)n;
+}
+
+}
+
+// ---- 세션 명령 ----
+
+uint32_t SessionTable::find(string_view id) const {
+    uint32_t index;
+    if (!parseNumber(id, index) || index >= m_sessions.size() || !m_sessions[index]) return NoSession;
+    return index;
+}
+
+void SessionTable::handle(string_view line, string& out) {
+    if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+    string_view t[4];
+    const int n = split(line, t, 4);
+    if (n == 0) return appendError(out, "empty command");
+    if (n > 4) return appendError(out, "too many arguments");
+    const string_view cmd = t[0];
+
+    if (cmd == "new") {
+        uint64_t seed = 0;
+        if (n > 2 || (n == 2 && !parseNumber(t[1], seed))) return appendError(out, "usage: new [seed]");
+        if (n == 1) seed = Market::randomSeed();
+        if (m_live >= m_limit) return appendError(out, "too many sessions");
+        //게임 화면과 같이 시작하자마자 첫날을 진행
+        auto m = make_unique<Market>(m_scenario, seed);
+        m->nextTurn();
+        uint32_t id;
+        if (!m_free.empty()) {
+            id = m_free.back();
+            m_free.pop_back();
+            m_sessions[id] = move(m);
+        } else {
+            id = (uint32_t)m_sessions.size();
+            m_sessions.push_back(move(m));
+        }
+        m_live++;
+        out += "{\"ok\":true,\"session\":";
+        appendNumber(out, (long long)id);
+        out += ",\"seed\":";
+        out += to_string(seed);
+        out += ",\"day\":";
+        appendNumber(out, (long long)m_sessions[id]->day());
+        out += "}\n";
+        return;
+    }
+
+    if (cmd != "buy" && cmd != "sell" && cmd != "next" && cmd != "list" && cmd != "history" && cmd != "news" &&
+        cmd != "close")
+        return appendError(out, "unknown command");
+    if (n < 2) return appendError(out, "missing session");
+    const uint32_t slot = find(t[1]);
+    if (slot == NoSession) return appendError(out, "unknown session");
+    Market* m = m_sessions[slot].get();
+
+    if (cmd == "buy" || cmd == "sell") {
+        int company, amount;
+        if (n != 4 || !parseNumber(t[2], company) || !parseNumber(t[3], amount))
+            return appendError(out, "usage: buy|sell session company amount");
+        if (m->isOver()) return appendError(out, "game is over");
+        if (company < 0 || company >= m->companyCount()) return appendError(out, "unknown company");
+        const bool filled = (cmd == "buy") ? m->buyStock(company, amount) : m->sellStock(company, amount);
+        if (!filled) return appendError(out, "not filled");
+        out += "{\"ok\":true,\"cash\":";
+        appendNumber(out, m->cash());
+        out += ",\"owned\":";
+        appendNumber(out, (long long)m->owned(company));
+        out += ",\"totalAsset\":";
+        appendNumber(out, m->totalAsset());
+        out += "}\n";
+    } else if (cmd == "next") {
+        if (n != 2) return appendError(out, "usage: next session");
+        if (m->isOver()) return appendError(out, "game is over");
+        m->nextTurn();
+        out += "{\"ok\":true,\"day\":";
+        appendNumber(out, (long long)m->day());
+        out += ",\"totalAsset\":";
+        appendNumber(out, m->totalAsset());
+        out += m->isOver() ? ",\"over\":true" : ",\"over\":false";
+        out += m->isVictory() ? ",\"victory\":true}\n" : ",\"victory\":false}\n";
+    } else if (cmd == "list") {
+        if (n != 2) return appendError(out, "usage: list session");
+        out += "{\"ok\":true,\"stocks\":[";
+        for (int i = 0; i < m->companyCount(); i++) {
+            out += i ? ",{\"name\":" : "{\"name\":";
+            appendJsonString(out, m->companyName(i));
+            out += ",\"price\":";
+            appendNumber(out, m->price(i));
+            out += ",\"owned\":";
+            appendNumber(out, (long long)m->owned(i));
+            out += ",\"changeRate\":";
+            appendNumber(out, m->changeRate(i));
+            out += "}";
+        }
+        out += "]}\n";
+    } else if (cmd == "history") {
+        int company;
+        size_t days = 0;
+        if ((n != 3 && n != 4) || !parseNumber(t[2], company) || (n == 4 && !parseNumber(t[3], days)))
+            return appendError(out, "usage: history session company [days]");
+        if (company < 0 || company >= m->companyCount()) return appendError(out, "unknown company");
+        out += "{\"ok\":true,\"history\":[";
+        const PriceHistory& history = m->history(company);
+        const size_t count = history.size();
+        const size_t begin = days ? count - min(count, days) : history.exactBegin();
+        bool first = true;
+        history.visit(begin, count, [&](const PriceHistory::Bucket& b, size_t repeat) {
+            for (size_t d = 0; d < repeat; d++, first = false) {
+                if (!first) out += ',';
+                appendNumber(out, b.last);
+            }
+        });
+        out += "]}\n";
+    } else if (cmd == "news") {
+        if (n != 2) return appendError(out, "usage: news session");
+        out += "{\"ok\":true,\"news\":[";
+        const vector<NewsItem>& items = m->todayNewsItems();
+        for (size_t i = 0; i < items.size(); i++) {
+            if (i) out += ',';
+            m_text.clear();
+            m->appendNewsText(items[i], m_text);
+            appendJsonString(out, m_text);
+        }
+        out += "]}\n";
+    } else if (cmd == "close") {
+        if (n != 2) return appendError(out, "usage: close session");
+        m_sessions[slot].reset();
+        m_free.push_back(slot);
+        m_live--;
+        out += "{\"ok\":true}\n";
+    }
+}
+
+// ---- 서버 ----
+
+struct GameServer::Connection {
+    explicit Connection(const shared_ptr<const Scenario>& scenario, size_t limit) : sessions(scenario, limit) {}
+    string in;
+    string out;
+    size_t sent = 0; //out 중 이미 보낸 바이트
+    SessionTable sessions;
+    bool reading = true; //epoll에 EPOLLIN을 걸어 두었는지
+    bool writing = false;
+    bool eof = false; //상대가 보내기를 끝냄 (남은 줄을 처리하고 닫음)
+};
+
+struct GameServer::Worker {
+    int epollFd = -1;
+    int wakeFd = -1; //eventfd (새 연결, 종료)
+    thread loop;
+    mutex incomingMutex;
+    vector<int> incoming; //받는 스레드가 넘긴 연결
+    unordered_map<int, unique_ptr<Connection>> connections;
+    atomic<uint64_t> connectionCount{0};
+    atomic<uint64_t> sessionCount{0};
+    atomic<uint64_t> commandCount{0};
+};
+
+GameServer::GameServer(shared_ptr<const Scenario> scenario, const Config& config)
+    : m_scenario(move(scenario)), m_config(config) {
+    if (m_config.workers == 0) m_config.workers = 1;
+}
+
+GameServer::~GameServer() {
+    stop();
+    for (auto& w : m_workers) {
+        if (w->loop.joinable()) w->loop.join();
+        for (auto& c : w->connections) close(c.first);
+        if (w->epollFd >= 0) close(w->epollFd);
+        if (w->wakeFd >= 0) close(w->wakeFd);
+    }
+    if (m_listenFd >= 0) close(m_listenFd);
+    if (m_stopFd >= 0) close(m_stopFd);
+}
+
+bool GameServer::start(string* error) {
+    auto fail = [&](const char* what) {
+        if (error) *error = string(what) + ": " + strerror(errno);
+        return false;
+    };
+    m_listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_listenFd < 0) return fail("socket");
+    const int on = 1;
+    setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof on);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(m_config.port);
+    addr.sin_addr.s_addr = htonl(m_config.loopbackOnly ? INADDR_LOOPBACK : INADDR_ANY);
+    if (bind(m_listenFd, (sockaddr*)&addr, sizeof addr) < 0) return fail("bind");
+    if (listen(m_listenFd, SOMAXCONN) < 0) return fail("listen");
+    socklen_t len = sizeof addr;
+    getsockname(m_listenFd, (sockaddr*)&addr, &len);
+    m_port = ntohs(addr.sin_port);
+
+    m_stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_stopFd < 0) return fail("eventfd");
+    for (unsigned i = 0; i < m_config.workers; i++) {
+        auto w = make_unique<Worker>();
+        w->epollFd = epoll_create1(EPOLL_CLOEXEC);
+        w->wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (w->epollFd < 0 || w->wakeFd < 0) return fail("epoll");
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = w->wakeFd;
+        epoll_ctl(w->epollFd, EPOLL_CTL_ADD, w->wakeFd, &ev);
+        m_workers.push_back(move(w));
+    }
+    for (auto& w : m_workers) w->loop = thread([this, wp = w.get()] { workerLoop(*wp); });
+    return true;
+}
+
+void GameServer::stop() {
+    m_stopping.store(true);
+    if (m_stopFd >= 0) writeEvent(m_stopFd);
+    for (auto& w : m_workers) writeEvent(w->wakeFd);
+}
+
+GameServer::Stats GameServer::stats() const {
+    Stats s;
+    for (const auto& w : m_workers) {
+        s.connections += w->connectionCount.load(memory_order_relaxed);
+        s.sessions += w->sessionCount.load(memory_order_relaxed);
+        s.commands += w->commandCount.load(memory_order_relaxed);
+    }
+    return s;
+}
+
+//받는 루프: 새 연결을 워커에게 돌아가며 넘김 (연결의 읽기/쓰기는 전부 워커가 함)
+void GameServer::run() {
+    const int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = m_listenFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, m_listenFd, &ev);
+    ev.data.fd = m_stopFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, m_stopFd, &ev);
+
+    epoll_event events[2];
+    while (!m_stopping.load()) {
+        const int ready = epoll_wait(epollFd, events, 2, -1);
+        if (ready < 0 && errno != EINTR) break;
+        for (int i = 0; i < ready; i++) {
+            if (events[i].data.fd != m_listenFd) continue;
+            while (true) {
+                const int fd = accept4(m_listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                if (fd < 0) {
+                    //EMFILE 등은 대기열에 남겨 두고 다음 기회에 (로그만)
+                    if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                        fprintf(stderr, "accept: %s\n", strerror(errno));
+                    break;
+                }
+                const int on = 1;
+                setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof on);
+                Worker& w = *m_workers[m_nextWorker];
+                m_nextWorker = (m_nextWorker + 1) % m_workers.size();
+                {
+                    lock_guard<mutex> lock(w.incomingMutex);
+                    w.incoming.push_back(fd);
+                }
+                writeEvent(w.wakeFd);
+            }
+        }
+    }
+    close(epollFd);
+    stop();
+    for (auto& w : m_workers) {
+        if (w->loop.joinable()) w->loop.join();
+    }
+}
+
+void GameServer::workerLoop(Worker& w) {
+    epoll_event events[MaxEvents];
+    vector<int> incoming;
+    while (!m_stopping.load()) {
+        const int ready = epoll_wait(w.epollFd, events, MaxEvents, -1);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        for (int i = 0; i < ready; i++) {
+            const int fd = events[i].data.fd;
+            if (fd == w.wakeFd) {
+                uint64_t count;
+                ssize_t n = read(w.wakeFd, &count, sizeof count);
+                (void)n;
+                {
+                    lock_guard<mutex> lock(w.incomingMutex);
+                    incoming.swap(w.incoming);
+                }
+                for (int c : incoming) {
+                    epoll_event ev{};
+                    ev.events = EPOLLIN | EPOLLRDHUP;
+                    ev.data.fd = c;
+                    if (epoll_ctl(w.epollFd, EPOLL_CTL_ADD, c, &ev) < 0) { close(c); continue; }
+                    w.connections.emplace(c, make_unique<Connection>(m_scenario, m_config.maxSessionsPerConnection));
+                    w.connectionCount.fetch_add(1, memory_order_relaxed);
+                }
+                incoming.clear();
+                continue;
+            }
+            auto it = w.connections.find(fd);
+            if (it == w.connections.end()) continue;
+            Connection& c = *it->second;
+            bool open = !(events[i].events & EPOLLERR);
+            if (open && !c.eof && (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)))
+                open = readInput(w, fd, c) || c.eof;
+            //상대가 보내기만 끝낸 경우(half-close)에는 남은 줄의 응답까지 다 보낸 뒤에 닫음
+            if (open) open = serve(w, fd, c) && !(c.eof && c.out.empty() && c.in.find('\n') == string::npos);
+            if (!open) closeConnection(w, fd);
+        }
+    }
+}
+
+//읽을 수 있는 만큼 읽어 in에 쌓음 (상대가 닫았거나 오류면 false)
+bool GameServer::readInput(Worker&, int fd, Connection& c) {
+    char buf[ReadChunk];
+    const ssize_t n = read(fd, buf, sizeof buf);
+    if (n == 0) {
+        c.eof = true;
+        return false;
+    }
+    if (n < 0) return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+    c.in.append(buf, (size_t)n);
+    return true;
+}
+
+//완성된 줄을 처리하고 응답을 보냄, 다 못 보낸 만큼은 EPOLLOUT을 걸어 두고 다음에
+bool GameServer::serve(Worker& w, int fd, Connection& c) {
+    size_t begin = 0;
+    while (true) {
+        //응답이 너무 밀렸으면 나머지 줄은 보낸 뒤에
+        const size_t end = c.out.size() - c.sent < OutputHighWater ? c.in.find('\n', begin) : string::npos;
+        if (end == string::npos) {
+            if (!flushOutput(fd, c)) return false;
+            //다 보냈는데 처리할 줄이 남았으면 계속
+            if (c.out.empty() && c.in.find('\n', begin) != string::npos) continue;
+            break;
+        }
+        const string_view line(c.in.data() + begin, end - begin);
+        if (line == "stats" || line == "stats\r") {
+            const Stats s = stats();
+            char buf[128];
+            c.out.append(buf, (size_t)snprintf(buf, sizeof buf,
+                         "{\"ok\":true,\"sessions\":%llu,\"connections\":%llu,\"commands\":%llu}\n",
+                         (unsigned long long)s.sessions, (unsigned long long)s.connections,
+                         (unsigned long long)s.commands));
+        } else {
+            const size_t before = c.sessions.size();
+            c.sessions.handle(line, c.out);
+            const size_t after = c.sessions.size();
+            if (after > before) w.sessionCount.fetch_add(after - before, memory_order_relaxed);
+            else if (after < before) w.sessionCount.fetch_sub(before - after, memory_order_relaxed);
+        }
+        w.commandCount.fetch_add(1, memory_order_relaxed);
+        begin = end + 1;
+    }
+    c.in.erase(0, begin);
+    if (c.in.size() > m_config.maxLineBytes && c.in.find('\n') == string::npos) return false;
+
+    //밀린 응답이 있으면 쓰기를 기다리고, 너무 많이 밀렸거나 상대가 보내기를 끝냈으면 읽기를 멈춤
+    const bool writing = !c.out.empty();
+    const bool reading = !c.eof && c.out.size() - c.sent < OutputHighWater;
+    if (writing != c.writing || reading != c.reading) {
+        epoll_event ev{};
+        ev.events = (reading ? EPOLLIN | EPOLLRDHUP : 0u) | (writing ? EPOLLOUT : 0u);
+        ev.data.fd = fd;
+        epoll_ctl(w.epollFd, EPOLL_CTL_MOD, fd, &ev);
+        c.writing = writing;
+        c.reading = reading;
+    }
+    return true;
+}
+
+//보낼 수 있는 만큼 보냄 (소켓 버퍼가 차면 남겨 둠, 오류면 false)
+bool GameServer::flushOutput(int fd, Connection& c) {
+    while (c.sent < c.out.size()) {
+        const ssize_t n = send(fd, c.out.data() + c.sent, c.out.size() - c.sent, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            if (errno == EINTR) continue;
+            return false;
+        }
+        c.sent += (size_t)n;
+    }
+    if (c.sent == c.out.size()) {
+        c.out.clear();
+        c.sent = 0;
+    }
+    return true;
+}
+
+void GameServer::closeConnection(Worker& w, int fd) {
+    auto it = w.connections.find(fd);
+    if (it == w.connections.end()) return;
+    w.sessionCount.fetch_sub(it->second->sessions.size(), memory_order_relaxed);
+    w.connectionCount.fetch_sub(1, memory_order_relaxed);
+    epoll_ctl(w.epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    w.connections.erase(it);
+}
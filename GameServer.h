@@ -0,0 +1,112 @@
+﻿#ifndef GAMESERVER_H
+#define GAMESERVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "Market.h"
+
+using namespace std;
+
+// 헤드리스 멀티 세션 게임 서버 (리눅스 epoll)
+// 한 프로세스가 게임(세션) 수천 개를 들고, 로컬 TCP의 줄 단위 텍스트 명령으로 거래/턴 진행/조회를 받습니다.
+// 연결은 받는 스레드가 워커들에게 돌아가며 나눠 주고, 세션은 만든 연결에 속하므로 워커 하나만 만집니다.
+// 그래서 워커끼리 잠금 없이 돌고, 세션이 공유하는 것은 읽기 전용 시나리오(shared_ptr) 하나뿐입니다.
+// 제한: 세션을 워커에 나누는 단위가 연결이라서, 연결 하나로 세션을 많이 돌리면 코어 하나만 씁니다.
+// 여러 코어를 쓰려면 연결을 여러 개 여세요(stockLoad처럼). 세션은 연결보다 오래 살지 않으므로
+// 다시 접속하면 이어 할 수 없습니다. 응답은 최대 한 번 전달됩니다: 상대가 보내기만 끝내면(half-close)
+// 남은 응답을 다 보낸 뒤 닫지만, 연결을 완전히 닫거나 끊기면 아직 못 보낸 응답은 버려집니다.
+// (명령은 적용됐는데 응답만 못 받았을 수 있음)
+//
+// 프로토콜: 요청 한 줄 → 응답 한 줄(JSON). 응답은 요청 순서대로 오므로 여러 줄을 한 번에 보내도 됩니다.
+//   new [seed]             새 게임 (첫날이 진행된 상태)  → {"ok":true,"session":S,"seed":N,"day":D}
+//   buy S company amount   시장가 매수                   → {"ok":true,"cash":..,"owned":..,"totalAsset":..}
+//   sell S company amount  시장가 매도                   → (buy와 같음)
+//   next S                 하루 진행                     → {"ok":true,"day":D,"totalAsset":..,"over":..,"victory":..}
+//   list S                 종목 목록                     → {"ok":true,"stocks":[{"name":..,"price":..,"owned":..,"changeRate":..}]}
+//   history S company [days] 최근 days일 종가 (없으면 원본이 남은 날 전부) → {"ok":true,"history":[..]}
+//   news S                 오늘의 뉴스                   → {"ok":true,"news":["..", ..]}
+//   close S                게임 끝내기                   → {"ok":true}
+//   stats                  서버 전체 세션/연결 수         → {"ok":true,"sessions":..,"connections":..,"commands":..}
+// 실패하면 {"ok":false,"error":".."}. 연결이 끊기면 그 연결의 세션도 모두 사라집니다.
+
+//연결 하나의 세션들과 명령 처리 (소켓과 무관, 한 스레드에서만 사용)
+class SessionTable {
+public:
+    SessionTable(shared_ptr<const Scenario> scenario, size_t limit) : m_scenario(move(scenario)), m_limit(limit) {}
+
+    //명령 한 줄을 처리하고 응답(JSON 한 줄, 줄바꿈 포함)을 out 뒤에 붙임
+    void handle(string_view line, string& out);
+
+    size_t size() const { return m_live; }
+
+private:
+    shared_ptr<const Scenario> m_scenario;
+    vector<unique_ptr<Market>> m_sessions; //세션 번호 = 인덱스 (닫힌 자리는 nullptr, 재사용)
+    vector<uint32_t> m_free;
+    size_t m_live = 0;
+    size_t m_limit;
+    string m_text; //뉴스 본문 조립용 (용량 재사용)
+
+    static constexpr uint32_t NoSession = 0xFFFFFFFFu;
+    //살아 있는 세션의 자리 번호 (없으면 NoSession)
+    uint32_t find(string_view id) const;
+};
+
+class GameServer {
+public:
+    struct Config {
+        uint16_t port = 7420;
+        unsigned workers = thread::hardware_concurrency();
+        bool loopbackOnly = true; //127.0.0.1에만 바인드
+        size_t maxLineBytes = 4096; //이보다 긴 명령 줄은 연결을 끊음
+        size_t maxSessionsPerConnection = 100000;
+    };
+    struct Stats {
+        uint64_t connections = 0; //지금 열린 연결
+        uint64_t sessions = 0; //지금 살아 있는 세션
+        uint64_t commands = 0; //처리한 명령 누계
+    };
+
+    GameServer(shared_ptr<const Scenario> scenario, const Config& config);
+    ~GameServer();
+
+    //포트를 열고 워커를 띄움 (실패하면 error에 이유)
+    bool start(string* error = nullptr);
+    //받는 루프 (stop()이 불릴 때까지 호출한 스레드를 막음)
+    void run();
+    //다른 스레드나 시그널 처리 뒤에서 불러도 됨
+    void stop();
+
+    uint16_t port() const { return m_port; }
+    Stats stats() const;
+
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+
+private:
+    struct Connection;
+    struct Worker;
+
+    shared_ptr<const Scenario> m_scenario;
+    Config m_config;
+    int m_listenFd = -1;
+    int m_stopFd = -1; //eventfd (받는 루프 깨우기)
+    uint16_t m_port = 0;
+    atomic<bool> m_stopping{false};
+    vector<unique_ptr<Worker>> m_workers;
+    size_t m_nextWorker = 0;
+
+    void workerLoop(Worker& w);
+    bool readInput(Worker& w, int fd, Connection& c);
+    bool serve(Worker& w, int fd, Connection& c);
+    bool flushOutput(int fd, Connection& c);
+    void closeConnection(Worker& w, int fd);
+};
+
+#endif // GAMESERVER_H
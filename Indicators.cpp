@@ -0,0 +1,167 @@
+﻿#include "Indicators.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+//웰퍼드 분산: 창이 덜 찼으면 값을 더하고, 찼으면 가장 오래된 값(old)과 바꿈
+void welford(int& n, double& mean, double& m2, int window, double x, double old) {
+    if (n < window) {
+        n++;
+        const double d = x - mean;
+        mean += d / n;
+        m2 += d * (x - mean);
+    } else {
+        const double next = mean + (x - old) / n;
+        m2 = max(0.0, m2 + (x - old) * (x - next + old - mean));
+        mean = next;
+    }
+}
+
+//와일더 평활: 기간이 찰 때까지는 단순 평균, 그 뒤로는 (이전 × (기간 - 1) + 새 값) / 기간
+void wilder(int& k, double& gain, double& loss, int period, double change) {
+    const double g = change > 0 ? change : 0.0;
+    const double l = change < 0 ? -change : 0.0;
+    if (k < period) {
+        k++;
+        gain += (g - gain) / k;
+        loss += (l - loss) / k;
+    } else {
+        gain = (gain * (period - 1) + g) / period;
+        loss = (loss * (period - 1) + l) / period;
+    }
+}
+
+double returnOf(double last, double price) { return last > 0 ? price / last - 1.0 : 0.0; }
+
+}
+
+void IndicatorEngine::configure(const IndicatorConfig& config, const vector<PriceHistory>& histories) {
+    IndicatorConfig c = config;
+    c.enabled &= IndicatorConfig::All;
+    c.smaWindow = clamp(c.smaWindow, 1, 1000);
+    c.emaPeriod = clamp(c.emaPeriod, 1, 1000);
+    c.volatilityWindow = clamp(c.volatilityWindow, 1, 1000);
+    c.rsiPeriod = clamp(c.rsiPeriod, 1, 1000);
+    m_config = c;
+    rebuild(histories);
+}
+
+void IndicatorEngine::rebuild(const vector<PriceHistory>& histories) {
+    const size_t companies = histories.size();
+    const unsigned on = m_config.enabled;
+    m_state.assign(companies, State{});
+    m_values.assign(companies, IndicatorValues{});
+    m_smaSeries.assign(companies, PriceHistory());
+    m_emaSeries.assign(companies, PriceHistory());
+    if (on & IndicatorConfig::Sma) m_smaRing.assign(companies * m_config.smaWindow, 0.0);
+    else m_smaRing.clear();
+    if (on & IndicatorConfig::Volatility) m_volRing.assign(companies * m_config.volatilityWindow, 0.0);
+    else m_volRing.clear();
+    if (!on) return;
+    for (size_t c = 0; c < companies; c++) {
+        histories[c].visit(0, histories[c].size(), [&](const PriceHistory::Bucket& b, size_t days) {
+            for (size_t d = 0; d < days; d++) push(c, b.last);
+        });
+    }
+}
+
+void IndicatorEngine::push(size_t company, double price) {
+    State& s = m_state[company];
+    if (s.hasPending) commit(company, s.pending);
+    s.pending = price;
+    s.hasPending = true;
+    const IndicatorValues& v = m_values[company] = evaluate(company, price);
+    if (m_config.enabled & IndicatorConfig::Sma) m_smaSeries[company].push(v.sma);
+    if (m_config.enabled & IndicatorConfig::Ema) m_emaSeries[company].push(v.ema);
+}
+
+void IndicatorEngine::revise(size_t company, double price) {
+    State& s = m_state[company];
+    if (!s.hasPending) return;
+    s.pending = price;
+    const IndicatorValues& v = m_values[company] = evaluate(company, price);
+    if (m_config.enabled & IndicatorConfig::Sma) m_smaSeries[company].setBack(v.sma);
+    if (m_config.enabled & IndicatorConfig::Ema) m_emaSeries[company].setBack(v.ema);
+}
+
+void IndicatorEngine::commit(size_t company, double price) {
+    State& s = m_state[company];
+    const unsigned on = m_config.enabled;
+    if (on & IndicatorConfig::Sma) {
+        const int window = m_config.smaWindow;
+        double* ring = &m_smaRing[company * window];
+        if (s.count < window) {
+            ring[s.count] = price;
+            s.sum += price;
+        } else {
+            s.sum += price - ring[s.smaHead];
+            ring[s.smaHead] = price;
+            s.smaHead = (s.smaHead + 1) % window;
+        }
+    }
+    if (on & IndicatorConfig::Ema) {
+        const double alpha = 2.0 / (m_config.emaPeriod + 1);
+        s.ema = (s.count == 0) ? price : s.ema + alpha * (price - s.ema);
+    }
+    if (s.count > 0) {
+        if (on & IndicatorConfig::Volatility) {
+            const int window = m_config.volatilityWindow;
+            double* ring = &m_volRing[company * window];
+            const double r = returnOf(s.last, price);
+            const bool full = s.returns == window;
+            welford(s.returns, s.mean, s.m2, window, r, full ? ring[s.volHead] : 0.0);
+            if (full) {
+                ring[s.volHead] = r;
+                s.volHead = (s.volHead + 1) % window;
+            } else {
+                ring[s.returns - 1] = r;
+            }
+        }
+        if (on & IndicatorConfig::Rsi) wilder(s.changes, s.avgGain, s.avgLoss, m_config.rsiPeriod, price - s.last);
+    }
+    if (on & IndicatorConfig::Drawdown) {
+        s.peak = max(s.peak, price);
+        const double drawdown = s.peak > 0 ? (price / s.peak - 1.0) * 100.0 : 0.0;
+        s.maxDrawdown = min(s.maxDrawdown, drawdown);
+    }
+    s.count++;
+    s.last = price;
+}
+
+//확정 상태에 price를 넣었다고 치고 값을 계산 (상태는 바꾸지 않음, commit과 같은 식)
+IndicatorValues IndicatorEngine::evaluate(size_t company, double price) const {
+    const State& s = m_state[company];
+    const unsigned on = m_config.enabled;
+    IndicatorValues v;
+    if (on & IndicatorConfig::Sma) {
+        const int window = m_config.smaWindow;
+        v.sma = (s.count < window) ? (s.sum + price) / (s.count + 1)
+                                   : (s.sum - m_smaRing[company * window + s.smaHead] + price) / window;
+    }
+    if (on & IndicatorConfig::Ema) {
+        const double alpha = 2.0 / (m_config.emaPeriod + 1);
+        v.ema = (s.count == 0) ? price : s.ema + alpha * (price - s.ema);
+    }
+    if (s.count > 0) {
+        if (on & IndicatorConfig::Volatility) {
+            const int window = m_config.volatilityWindow;
+            int n = s.returns;
+            double mean = s.mean, m2 = s.m2;
+            welford(n, mean, m2, window, returnOf(s.last, price), n == window ? m_volRing[company * window + s.volHead] : 0.0);
+            v.volatility = n > 1 ? sqrt(m2 / (n - 1)) * 100.0 : 0.0;
+        }
+        if (on & IndicatorConfig::Rsi) {
+            int k = s.changes;
+            double gain = s.avgGain, loss = s.avgLoss;
+            wilder(k, gain, loss, m_config.rsiPeriod, price - s.last);
+            v.rsi = (gain + loss > 0) ? 100.0 * gain / (gain + loss) : 50.0;
+        }
+    }
+    if (on & IndicatorConfig::Drawdown) {
+        const double peak = max(s.peak, price);
+        v.drawdown = peak > 0 ? (price / peak - 1.0) * 100.0 : 0.0;
+        v.maxDrawdown = min(s.maxDrawdown, v.drawdown);
+    }
+    return v;
+}
@@ -0,0 +1,94 @@
+﻿#ifndef INDICATORS_H
+#define INDICATORS_H
+
+#include <cstddef>
+#include <vector>
+#include "PriceHistory.h"
+
+using namespace std;
+
+// 보조 지표 (이동평균, 지수이동평균, 변동성, RSI, 낙폭)
+// 회사마다 누적값(고정 크기 링 버퍼, 웰퍼드 분산, 와일더 평균, 고점)만 들고 있어서 종가 하나당 O(1)로 갱신합니다.
+// 오늘 종가는 거래 체결로 바뀔 수 있으므로 "확정 상태(어제까지) + 오늘 가격"으로 값을 계산해 두고,
+// 다음 종가가 붙을 때 비로소 오늘 가격을 확정 상태에 넣습니다. 그래서 체결 후 다시 계산해도 O(1)이고,
+// history만 있으면 처음부터 다시 쌓아 같은 값을 만들 수 있어 저장 파일에는 지표를 넣지 않습니다.
+// (단, history에서 봉으로 묶인 아주 오래된 날은 봉의 마지막 값으로 채워 쌓으므로 그 구간만 근사값입니다.)
+
+struct IndicatorConfig {
+    enum : unsigned { Sma = 1, Ema = 2, Volatility = 4, Rsi = 8, Drawdown = 16, All = 31 };
+    unsigned enabled = 0; //켤 지표 (비트 조합, 0이면 끔)
+    int smaWindow = 5; //이동평균 기간 (일)
+    int emaPeriod = 20; //지수이동평균 기간 (일, 가중치 2 / (기간 + 1))
+    int volatilityWindow = 20; //변동성을 잴 일간 수익률 개수
+    int rsiPeriod = 14; //RSI 기간 (와일더 평활)
+
+    bool operator==(const IndicatorConfig& o) const {
+        return enabled == o.enabled && smaWindow == o.smaWindow && emaPeriod == o.emaPeriod &&
+               volatilityWindow == o.volatilityWindow && rsiPeriod == o.rsiPeriod;
+    }
+};
+
+//회사 하나의 현재 지표 값 (기록이 기간보다 짧으면 있는 만큼으로 계산)
+struct IndicatorValues {
+    double sma = 0;
+    double ema = 0;
+    double volatility = 0; //일간 수익률 표준편차 (%)
+    double rsi = 50;
+    double drawdown = 0; //고점 대비 현재 낙폭 (%, 0 이하)
+    double maxDrawdown = 0; //지금까지 가장 큰 낙폭 (%, 0 이하)
+};
+
+class IndicatorEngine {
+public:
+    //설정을 바꾸고 기록 전체로 다시 쌓음 (기간은 1~1000일로 제한)
+    void configure(const IndicatorConfig& config, const vector<PriceHistory>& histories);
+    //기록이 통째로 바뀌었을 때 (새 게임, 불러오기)
+    void rebuild(const vector<PriceHistory>& histories);
+
+    bool enabled() const { return m_config.enabled != 0; }
+    const IndicatorConfig& config() const { return m_config; }
+
+    //새 종가가 기록에 붙은 직후: 전날 가격을 확정하고 오늘 값을 계산 (회사끼리 독립이라 병렬로 불러도 됨)
+    void push(size_t company, double price);
+    //오늘 가격이 체결로 바뀌었을 때: 확정 상태는 그대로 두고 오늘 값만 다시 계산
+    void revise(size_t company, double price);
+
+    const IndicatorValues& values(size_t company) const { return m_values[company]; }
+    //차트 오버레이용 날짜별 값 (history와 길이가 같음, 꺼져 있으면 비어 있음)
+    const PriceHistory& smaSeries(size_t company) const { return m_smaSeries[company]; }
+    const PriceHistory& emaSeries(size_t company) const { return m_emaSeries[company]; }
+
+private:
+    //어제까지 확정된 누적값
+    struct State {
+        int count = 0; //확정된 가격 수
+        double last = 0; //마지막 확정 가격
+        double pending = 0; //오늘 가격 (아직 확정 전)
+        bool hasPending = false;
+        double sum = 0; //이동평균 창의 합
+        int smaHead = 0; //링 버퍼에서 가장 오래된 자리
+        double ema = 0;
+        int returns = 0; //변동성 창에 든 수익률 수
+        int volHead = 0;
+        double mean = 0; //웰퍼드 평균/제곱편차합 (수익률 창)
+        double m2 = 0;
+        int changes = 0; //RSI에 들어간 가격 변화 수
+        double avgGain = 0;
+        double avgLoss = 0;
+        double peak = 0;
+        double maxDrawdown = 0;
+    };
+
+    IndicatorConfig m_config;
+    vector<State> m_state;
+    vector<double> m_smaRing; //회사 × smaWindow
+    vector<double> m_volRing; //회사 × volatilityWindow
+    vector<IndicatorValues> m_values;
+    vector<PriceHistory> m_smaSeries; //종가 기록과 같은 방식으로 메모리 상한
+    vector<PriceHistory> m_emaSeries;
+
+    void commit(size_t company, double price);
+    IndicatorValues evaluate(size_t company, double price) const;
+};
+
+#endif // INDICATORS_H
@@ -0,0 +1,59 @@
+﻿#include "Intraday.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+void simulateIntradayDay(const IntradayConfig& config, RandomStream& rng, double open, double close,
+                         double* scratch, Bar* bars, Bar& day) {
+    const int ticks = config.ticks;
+    const double sigma = open * config.volatility;
+
+    //1단계: 틱별 변동([-1, 1) 균등분포)과 그 합
+    //난수 생성이 틱 비용의 대부분이라 32비트 난수 하나를 16비트씩 나눠 틱 두 개에 씀 (경로 해상도로는 충분)
+    double walk = 0;
+    for (int i = 0; i < ticks; i += 2) {
+        const uint32_t r = rng.next();
+        scratch[i] = int16_t(r) * (1.0 / 32768.0);
+        walk += scratch[i];
+        if (i + 1 < ticks) {
+            scratch[i + 1] = int16_t(r >> 16) * (1.0 / 32768.0);
+            walk += scratch[i + 1];
+        }
+    }
+
+    //2단계: 누적 변동에서 평균 기울기를 빼서 끝점을 0으로 묶고(브라운 다리), 시가→종가 기울기를 더하며 봉으로 합침
+    //가격 = 시가 + slope × 틱 번호 + sigma × 누적 변동 (틱은 만들자마자 봉에 합치고 버림)
+    const double slope = (close - open) / ticks - sigma * (walk / ticks);
+    const double floorPrice = min(open, close) * 0.01; //가격이 0 이하로 내려가지 않도록
+    double cumulative = 0, price = open;
+    day = { open, open, open, close, 0 };
+    Bar* b = bars;
+    for (int i = 0; i < ticks; b++) {
+        const int end = min(ticks, i + config.ticksPerBar);
+        const int count = end - i;
+        double high = price, low = price, spread = 0;
+        *b = { price, price, price, price, 0 };
+        for (; i < end; i++) {
+            cumulative += scratch[i];
+            price = max(floorPrice, open + slope * (i + 1) + sigma * cumulative);
+            high = max(high, price);
+            low = min(low, price);
+            spread += fabs(scratch[i]);
+        }
+        //거래량은 틱마다 평균 × (0.5 + |변동|), 봉 단위로 반올림
+        b->volume = round(config.volume * (0.5 * count + spread));
+        if (i == ticks) {
+            //반올림 오차 없이 마지막 틱을 종가에 맞춤
+            price = close;
+            high = max(high, close);
+            low = min(low, close);
+        }
+        b->high = high;
+        b->low = low;
+        b->close = price;
+        day.high = max(day.high, high);
+        day.low = min(day.low, low);
+        day.volume += b->volume;
+    }
+}
@@ -0,0 +1,37 @@
+﻿#ifndef INTRADAY_H
+#define INTRADAY_H
+
+#include "Random.h"
+
+// 장중 틱 모드
+// 하루를 틱 여러 개로 나눠 가격 경로를 만들고, 틱은 저장하지 않고 바로 고정 크기 봉(OHLC/거래량)으로 합칩니다.
+// 경로는 시가(전날 종가) → 종가의 브라운 다리라서 종가는 하루 단위 계산과 비트 단위로 같습니다.
+// 그래서 장중 모드를 켜도 게임 결과(저널/밸런스)는 그대로이고, 이벤트 영향(시가-종가 차이)은 틱마다 고르게 나뉩니다.
+
+//봉 하나 (일봉/장중 봉 공용)
+struct Bar {
+    double open;
+    double high;
+    double low;
+    double close;
+    double volume; //거래량 (주)
+};
+
+struct IntradayConfig {
+    int ticks = 0; //하루 틱 수 (0이면 장중 모드 끔, 예: 390 = 1분봉 6시간 30분)
+    int ticksPerBar = 30; //봉 하나에 합치는 틱 수
+    double volatility = 0.002; //틱 하나의 최대 변동폭 (시가 대비)
+    double volume = 100; //틱 하나의 평균 거래량 (주)
+
+    int barsPerDay() const { return ticks > 0 ? (ticks + ticksPerBar - 1) / ticksPerBar : 0; }
+    bool operator==(const IntradayConfig& o) const {
+        return ticks == o.ticks && ticksPerBar == o.ticksPerBar && volatility == o.volatility && volume == o.volume;
+    }
+};
+
+//하루치 틱을 만들면서 장중 봉(bars, barsPerDay개)과 일봉(day)을 채웁니다.
+//scratch는 틱 수만큼의 작업 공간입니다. (호출마다 할당하지 않도록 밖에서 재사용)
+void simulateIntradayDay(const IntradayConfig& config, RandomStream& rng, double open, double close,
+                         double* scratch, Bar* bars, Bar& day);
+
+#endif // INTRADAY_H
@@ -0,0 +1,216 @@
+﻿#include "Json.h"
+#include <cstdint>
+#include <cstdlib>
+
+namespace {
+
+class Parser {
+public:
+    explicit Parser(string_view text) : m_text(text) {}
+
+    bool parse(JsonValue& out, string* error) {
+        skipSpace();
+        if (!value(out, 0)) return fail(error);
+        skipSpace();
+        if (m_pos != m_text.size()) { m_error = "unexpected trailing characters"; return fail(error); }
+        return true;
+    }
+
+private:
+    static constexpr int MaxDepth = 64;
+
+    string_view m_text;
+    size_t m_pos = 0;
+    string m_error;
+
+    bool fail(string* error) {
+        if (!error) return false;
+        //오류 위치를 줄/열로 변환
+        int line = 1, column = 1;
+        for (size_t i = 0; i < m_pos && i < m_text.size(); i++) {
+            if (m_text[i] == '\n') { line++; column = 1; }
+            else column++;
+        }
+        *error = to_string(line) + ":" + to_string(column) + ": " + m_error;
+        return false;
+    }
+
+    bool bad(const char* message) { m_error = message; return false; }
+
+    char peek() const { return m_pos < m_text.size() ? m_text[m_pos] : '\0'; }
+
+    void skipSpace() {
+        while (m_pos < m_text.size()) {
+            char c = m_text[m_pos];
+            if (c == ' ' || c == '\t' || c == '\n' || c == '\r') m_pos++;
+            else break;
+        }
+    }
+
+    bool literal(const char* word) {
+        size_t n = char_traits<char>::length(word);
+        if (m_text.substr(m_pos, n) != word) return bad("invalid literal");
+        m_pos += n;
+        return true;
+    }
+
+    bool value(JsonValue& out, int depth) {
+        if (depth > MaxDepth) return bad("nesting too deep");
+        switch (peek()) {
+        case '{': return object(out, depth);
+        case '[': return array(out, depth);
+        case '"': out.type = JsonValue::String; return str(out.text);
+        case 't': out.type = JsonValue::Bool; out.boolean = true; return literal("true");
+        case 'f': out.type = JsonValue::Bool; out.boolean = false; return literal("false");
+        case 'n': out.type = JsonValue::Null; return literal("null");
+        default: return number(out);
+        }
+    }
+
+    bool object(JsonValue& out, int depth) {
+        out.type = JsonValue::Object;
+        m_pos++;
+        skipSpace();
+        if (peek() == '}') { m_pos++; return true; }
+        while (true) {
+            skipSpace();
+            if (peek() != '"') return bad("expected member name");
+            string key;
+            if (!str(key)) return false;
+            skipSpace();
+            if (peek() != ':') return bad("expected ':'");
+            m_pos++;
+            skipSpace();
+            out.members.emplace_back(move(key), JsonValue());
+            if (!value(out.members.back().second, depth + 1)) return false;
+            skipSpace();
+            if (peek() == ',') { m_pos++; continue; }
+            if (peek() == '}') { m_pos++; return true; }
+            return bad("expected ',' or '}'");
+        }
+    }
+
+    bool array(JsonValue& out, int depth) {
+        out.type = JsonValue::Array;
+        m_pos++;
+        skipSpace();
+        if (peek() == ']') { m_pos++; return true; }
+        while (true) {
+            skipSpace();
+            out.items.emplace_back();
+            if (!value(out.items.back(), depth + 1)) return false;
+            skipSpace();
+            if (peek() == ',') { m_pos++; continue; }
+            if (peek() == ']') { m_pos++; return true; }
+            return bad("expected ',' or ']'");
+        }
+    }
+
+    bool number(JsonValue& out) {
+        size_t start = m_pos;
+        if (peek() == '-') m_pos++;
+        bool digits = false;
+        while (m_pos < m_text.size()) {
+            char c = m_text[m_pos];
+            if ((c >= '0' && c <= '9')) digits = true;
+            else if (c != '.' && c != 'e' && c != 'E' && c != '+' && c != '-') break;
+            m_pos++;
+        }
+        if (!digits) { m_pos = start; return bad("unexpected character"); }
+        string token(m_text.substr(start, m_pos - start));
+        char* end = nullptr;
+        out.type = JsonValue::Number;
+        out.number = strtod(token.c_str(), &end);
+        if (end != token.c_str() + token.size()) { m_pos = start; return bad("invalid number"); }
+        return true;
+    }
+
+    static void appendUtf8(string& out, uint32_t cp) {
+        if (cp < 0x80) out += char(cp);
+        else if (cp < 0x800) { out += char(0xC0 | (cp >> 6)); out += char(0x80 | (cp & 0x3F)); }
+        else if (cp < 0x10000) {
+            out += char(0xE0 | (cp >> 12)); out += char(0x80 | ((cp >> 6) & 0x3F)); out += char(0x80 | (cp & 0x3F));
+        } else {
+            out += char(0xF0 | (cp >> 18)); out += char(0x80 | ((cp >> 12) & 0x3F));
+            out += char(0x80 | ((cp >> 6) & 0x3F)); out += char(0x80 | (cp & 0x3F));
+        }
+    }
+
+    bool hex4(uint32_t& cp) {
+        if (m_pos + 4 > m_text.size()) return bad("truncated \\u escape");
+        cp = 0;
+        for (int i = 0; i < 4; i++) {
+            char c = m_text[m_pos++];
+            cp <<= 4;
+            if (c >= '0' && c <= '9') cp |= uint32_t(c - '0');
+            else if (c >= 'a' && c <= 'f') cp |= uint32_t(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') cp |= uint32_t(c - 'A' + 10);
+            else return bad("invalid \\u escape");
+        }
+        return true;
+    }
+
+    bool str(string& out) {
+        m_pos++; //여는 따옴표
+        while (true) {
+            if (m_pos >= m_text.size()) return bad("unterminated string");
+            char c = m_text[m_pos++];
+            if (c == '"') return true;
+            if ((unsigned char)c < 0x20) return bad("control character in string");
+            if (c != '\\') { out += c; continue; }
+            if (m_pos >= m_text.size()) return bad("unterminated string");
+            switch (m_text[m_pos++]) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                uint32_t cp;
+                if (!hex4(cp)) return false;
+                //서로게이트 쌍
+                if (cp >= 0xD800 && cp < 0xDC00) {
+                    uint32_t low;
+                    if (m_text.substr(m_pos, 2) != "\\u") return bad("unpaired surrogate");
+                    m_pos += 2;
+                    if (!hex4(low) || low < 0xDC00 || low >= 0xE000) return bad("unpaired surrogate");
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                }
+                appendUtf8(out, cp);
+                break;
+            }
+            default: return bad("invalid escape");
+            }
+        }
+    }
+};
+
+}
+
+bool parseJson(string_view text, JsonValue& out, string* error) {
+    //UTF-8 BOM은 건너뜀
+    if (text.substr(0, 3) == "\xEF\xBB\xBF") text.remove_prefix(3);
+    out = JsonValue();
+    return Parser(text).parse(out, error);
+}
+
+void appendJsonString(string& out, string_view s) {
+    static const char* hex = "0123456789abcdef";
+    out += '"';
+    for (char c : s) {
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if ((unsigned char)c < 0x20) { out += "\\u00"; out += hex[(c >> 4) & 0xF]; out += hex[c & 0xF]; }
+            else out += c;
+        }
+    }
+    out += '"';
+}
@@ -0,0 +1,35 @@
+﻿#ifndef JSON_H
+#define JSON_H
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// 시나리오 작성 파일용 최소 JSON 값 (외부 라이브러리 없이 코어에서 사용)
+// 로드 시 한 번만 읽고 버리는 용도라 속도보다 단순함과 오류 위치 표시를 우선합니다.
+struct JsonValue {
+    enum Type { Null, Bool, Number, String, Array, Object };
+
+    Type type = Null;
+    bool boolean = false;
+    double number = 0;
+    string text;
+    vector<JsonValue> items; //배열 원소
+    vector<pair<string, JsonValue>> members; //객체 멤버 (작성 순서 유지)
+
+    const JsonValue* find(const string& key) const {
+        for (const auto& m : members) { if (m.first == key) return &m.second; }
+        return nullptr;
+    }
+};
+
+//실패하면 error에 "줄:열: 이유"를 남깁니다.
+bool parseJson(string_view text, JsonValue& out, string* error = nullptr);
+
+//문자열을 따옴표와 이스케이프를 붙여 out 뒤에 이어 붙임
+void appendJsonString(string& out, string_view s);
+
+#endif // JSON_H
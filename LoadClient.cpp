@@ -0,0 +1,269 @@
+﻿// 게임 서버 부하 생성기
+// 루프백으로 연결 C개를 열고 세션 S개를 나눠 만든 뒤, 세션마다 하루씩 (가끔 목록 조회) → 매수/매도 → 다음 날을
+// 반복합니다. 연결마다 한 라운드(자기 세션 전부의 명령)를 한 번에 보내고 응답이 다 오면 바로 다음 라운드를 보내는
+// 닫힌 루프라서, 처리량과 라운드 지연(p50/p99)이 서버 쪽 한계를 그대로 보여줍니다.
+//
+// 사용법: stockLoad [--port P] [--connections C] [--sessions S] [--days D] [--seed N]
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <string_view>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+using Clock = chrono::steady_clock;
+
+struct Options {
+    int port = 7420;
+    int connections = 64;
+    int sessions = 10000;
+    int days = 30; //세션마다 진행할 날 수 (게임이 먼저 끝나면 거기까지)
+    uint64_t seed = 20240601; //세션 i의 게임 시드 = seed + i
+};
+
+bool parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        const char* v = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!strcmp(a, "--port") && v) { opt.port = atoi(v); i++; }
+        else if (!strcmp(a, "--connections") && v) { opt.connections = atoi(v); i++; }
+        else if (!strcmp(a, "--sessions") && v) { opt.sessions = atoi(v); i++; }
+        else if (!strcmp(a, "--days") && v) { opt.days = atoi(v); i++; }
+        else if (!strcmp(a, "--seed") && v) { opt.seed = strtoull(v, nullptr, 10); i++; }
+        else return false;
+    }
+    return opt.connections > 0 && opt.sessions > 0 && opt.days >= 0;
+}
+
+enum Kind : uint8_t { New, List, Buy, Sell, Next };
+
+struct Session {
+    long long id = -1; //서버가 준 세션 번호
+    bool over = false;
+};
+
+struct Connection {
+    int fd = -1;
+    vector<Session> sessions;
+    vector<pair<uint32_t, Kind>> sent; //이번 라운드에 보낸 명령 (응답 순서와 같음)
+    size_t answered = 0;
+    string out;
+    size_t written = 0;
+    string in;
+    int round = 0; //0 = 세션 만들기, 1.. = 날
+    Clock::time_point roundStart;
+    bool finished = false;
+};
+
+struct Totals {
+    uint64_t commands = 0;
+    uint64_t rejected = 0; //ok:false (체결 안 됨, 게임 끝 등)
+    uint64_t finishedGames = 0;
+    int companies = 0; //첫 목록 응답에서 셈
+    vector<double> roundMs;
+};
+
+long long field(string_view line, string_view key) {
+    const size_t at = line.find(key);
+    return at == string_view::npos ? -1 : atoll(line.data() + at + key.size());
+}
+
+//다음 라운드 명령을 out에 씀 (보낼 것이 없으면 false)
+bool buildRound(Connection& c, const Options& opt, const Totals& totals, uint32_t firstSession) {
+    c.sent.clear();
+    c.answered = 0;
+    c.out.clear();
+    c.written = 0;
+    char line[96];
+    if (c.round == 0) {
+        for (uint32_t i = 0; i < c.sessions.size(); i++) {
+            c.out.append(line, (size_t)snprintf(line, sizeof line, "new %llu\n",
+                                                (unsigned long long)(opt.seed + firstSession + i)));
+            c.sent.push_back({ i, New });
+        }
+    } else if (c.round <= opt.days) {
+        const int day = c.round;
+        const int companies = max(1, totals.companies);
+        for (uint32_t i = 0; i < c.sessions.size(); i++) {
+            const Session& s = c.sessions[i];
+            if (s.id < 0 || s.over) continue;
+            //화면을 여는 플레이어처럼 닷새에 한 번 목록 조회, 매일 한 종목 매수 (사흘에 한 번은 매도)
+            if (day % 5 == 1) {
+                c.out.append(line, (size_t)snprintf(line, sizeof line, "list %lld\n", s.id));
+                c.sent.push_back({ i, List });
+            }
+            const int company = (int)((firstSession + i + day) % companies);
+            const bool sell = day % 3 == 0;
+            c.out.append(line, (size_t)snprintf(line, sizeof line, "%s %lld %d 10\n", sell ? "sell" : "buy", s.id, company));
+            c.sent.push_back({ i, sell ? Sell : Buy });
+            c.out.append(line, (size_t)snprintf(line, sizeof line, "next %lld\n", s.id));
+            c.sent.push_back({ i, Next });
+        }
+    }
+    c.roundStart = Clock::now();
+    return !c.sent.empty();
+}
+
+//받은 응답 한 줄을 반영
+void onResponse(Connection& c, string_view line, Totals& totals) {
+    const auto [index, kind] = c.sent[c.answered++];
+    Session& s = c.sessions[index];
+    totals.commands++;
+    const bool ok = line.find("\"ok\":true") != string_view::npos;
+    if (!ok) {
+        totals.rejected++;
+        if (line.find("game is over") != string_view::npos && !s.over) { s.over = true; totals.finishedGames++; }
+        return;
+    }
+    if (kind == New) s.id = field(line, "\"session\":");
+    if (kind == List && totals.companies == 0) {
+        int names = 0;
+        for (size_t at = line.find("\"name\":"); at != string_view::npos; at = line.find("\"name\":", at + 1)) names++;
+        totals.companies = names;
+    }
+    if (kind == Next && line.find("\"over\":true") != string_view::npos && !s.over) { s.over = true; totals.finishedGames++; }
+}
+
+//보낼 수 있는 만큼 보내고, 남았으면 EPOLLOUT을 걸어 둠
+bool flush(int epollFd, uint32_t index, Connection& c) {
+    while (c.written < c.out.size()) {
+        const ssize_t n = send(c.fd, c.out.data() + c.written, c.out.size() - c.written, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) return false;
+            break;
+        }
+        c.written += (size_t)n;
+    }
+    epoll_event ev{};
+    ev.events = EPOLLIN | (c.written < c.out.size() ? EPOLLOUT : 0u);
+    ev.data.u32 = index;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, c.fd, &ev);
+    return true;
+}
+
+int connectLoopback(int port) {
+    const int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, (sockaddr*)&addr, sizeof addr) < 0) { close(fd); return -1; }
+    const int on = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof on);
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    return fd;
+}
+
+double percentile(vector<double>& v, double p) {
+    if (v.empty()) return 0;
+    const size_t k = min(v.size() - 1, (size_t)(p * (v.size() - 1) + 0.5));
+    nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        fprintf(stderr, "usage: %s [--port P] [--connections C] [--sessions S] [--days D] [--seed N]\n", argv[0]);
+        return 1;
+    }
+    opt.connections = min(opt.connections, opt.sessions);
+
+    const int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    vector<Connection> conns(opt.connections);
+    vector<uint32_t> firstSession(opt.connections);
+    for (int i = 0; i < opt.connections; i++) {
+        Connection& c = conns[i];
+        c.fd = connectLoopback(opt.port);
+        if (c.fd < 0) { fprintf(stderr, "connect 127.0.0.1:%d: %s\n", opt.port, strerror(errno)); return 1; }
+        //세션을 연결마다 고르게 (앞 연결부터 하나씩 더)
+        const int count = opt.sessions / opt.connections + (i < opt.sessions % opt.connections ? 1 : 0);
+        firstSession[i] = i == 0 ? 0 : firstSession[i - 1] + (uint32_t)conns[i - 1].sessions.size();
+        c.sessions.resize(count);
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.u32 = (uint32_t)i;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, c.fd, &ev);
+    }
+
+    Totals totals;
+    const auto start = Clock::now();
+    Clock::time_point created = start;
+    int creating = opt.connections; //세션 만들기 라운드가 남은 연결 수
+    int active = opt.connections;
+    for (int i = 0; i < opt.connections; i++) {
+        buildRound(conns[i], opt, totals, firstSession[i]);
+        if (!flush(epollFd, (uint32_t)i, conns[i])) { fprintf(stderr, "send: %s\n", strerror(errno)); return 1; }
+    }
+
+    vector<epoll_event> events(256);
+    char buf[64 * 1024];
+    while (active > 0) {
+        const int ready = epoll_wait(epollFd, events.data(), (int)events.size(), 5000);
+        if (ready == 0) { fprintf(stderr, "timed out waiting for the server\n"); return 1; }
+        if (ready < 0) { if (errno == EINTR) continue; perror("epoll_wait"); return 1; }
+        for (int e = 0; e < ready; e++) {
+            const uint32_t i = events[e].data.u32;
+            Connection& c = conns[i];
+            if (c.finished) continue;
+            if ((events[e].events & EPOLLOUT) && !flush(epollFd, i, c)) { fprintf(stderr, "send: %s\n", strerror(errno)); return 1; }
+            if (!(events[e].events & EPOLLIN)) continue;
+            const ssize_t n = read(c.fd, buf, sizeof buf);
+            if (n == 0) { fprintf(stderr, "server closed the connection\n"); return 1; }
+            if (n < 0) continue;
+            c.in.append(buf, (size_t)n);
+            size_t begin = 0;
+            for (size_t end; (end = c.in.find('\n', begin)) != string::npos; begin = end + 1) {
+                if (c.answered >= c.sent.size()) { fprintf(stderr, "unexpected response\n"); return 1; }
+                onResponse(c, string_view(c.in.data() + begin, end - begin), totals);
+            }
+            c.in.erase(0, begin);
+            if (c.answered < c.sent.size()) continue;
+
+            //라운드 끝: 지연 기록 후 다음 라운드
+            totals.roundMs.push_back(chrono::duration<double, milli>(Clock::now() - c.roundStart).count());
+            if (c.round == 0 && --creating == 0) created = Clock::now();
+            c.round++;
+            if (!buildRound(c, opt, totals, firstSession[i])) {
+                c.finished = true;
+                active--;
+                continue;
+            }
+            if (!flush(epollFd, i, c)) { fprintf(stderr, "send: %s\n", strerror(errno)); return 1; }
+        }
+    }
+    const auto end = Clock::now();
+    for (auto& c : conns) close(c.fd);
+    close(epollFd);
+
+    const double total = chrono::duration<double>(end - start).count();
+    const double setup = chrono::duration<double>(created - start).count();
+    printf("sessions   : %d over %d connections (%d companies each)\n", opt.sessions, opt.connections, totals.companies);
+    printf("create     : %.3f s (%.0f sessions/s)\n", setup, setup > 0 ? opt.sessions / setup : 0.0);
+    printf("commands   : %llu in %.3f s (%.0f commands/s, %llu rejected)\n", (unsigned long long)totals.commands, total,
+           total > 0 ? totals.commands / total : 0.0, (unsigned long long)totals.rejected);
+    printf("games over : %llu\n", (unsigned long long)totals.finishedGames);
+    printf("round ms   : p50 %.2f  p99 %.2f  max %.2f (%zu rounds)\n", percentile(totals.roundMs, 0.5),
+           percentile(totals.roundMs, 0.99), totals.roundMs.empty() ? 0.0 : *max_element(totals.roundMs.begin(), totals.roundMs.end()),
+           totals.roundMs.size());
+    return 0;
+}
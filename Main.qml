@@ -25,22 +25,20 @@ ApplicationWindow {
 
     property string newsTitle: backend.newsTitle
     property string newsBody: backend.newsBody
+    property bool settleAfterAdvance: false
 
     // --- 데이터 모델 ---
-    ListModel { id: stockModel }
+    // 종목 목록은 C++ 모델(backend.stockModel)이 바뀐 행만 알려줍니다.
+    property var stockModel: backend.stockModel
 
     // 데이터 변경 감지
     Connections {
         target: backend
-        function onDataChanged() { updateStockList() }
-
-        function onNewsChanged() {
-            newsHistoryModel.append({
-                // [수정] 날짜 UI와 싱크를 맞추기 위해 -1 보정
-                dayIdx: backend.day - 1,
-                title: backend.newsTitle,
-                body: backend.newsBody
-            })
+
+        // 작업 스레드 정산이 끝나면 정산 결과 표시 (게임 시작 직후는 제외)
+        function onAdvanceFinished() {
+            if (window.settleAfterAdvance && window.day <= window.maxDay) settlementPopup.open()
+            window.settleAfterAdvance = false
         }
 
         function onGameOver(isVictory, message) {
@@ -50,22 +48,8 @@ ApplicationWindow {
         }
     }
 
-    function updateStockList() {
-        var list = backend.stockList
-        stockModel.clear()
-        for(var i=0; i<list.length; i++) {
-            stockModel.append(list[i])
-        }
-    }
-
-    Component.onCompleted: updateStockList()
-
-    // 뉴스 히스토리 모델
-    ListModel {
-        id: newsHistoryModel
-        // 초기 상태는 0일차로 표기 or 시작 전 메시지
-        ListElement { dayIdx: 0; title: "사전 브리핑"; body: "주식 시장 개장을 준비 중입니다." }
-    }
+    // 뉴스 히스토리는 C++ 모델(backend.newsModel)이 뉴스 ID로 보관합니다. (행 0은 사전 브리핑)
+    property var newsModel: backend.newsModel
 
     // --- 화면 1: 메인 메뉴 ---
     Rectangle {
@@ -102,7 +86,30 @@ ApplicationWindow {
                 }
                 onClicked: {
                     // 게임 시작 시 바로 1일차로 넘어가며 이벤트 발생
-                    backend.nextTurn()
+                    window.settleAfterAdvance = false
+                    backend.advanceDays(1)
+                    mainScreen.visible = false;
+                    gameScreen.visible = true
+                }
+            }
+            Button {
+                // 저장된 게임이 있을 때만 표시 (스냅샷 + 저널로 마지막 상태 복원)
+                text: "이어하기"
+                visible: backend.canResume
+                Layout.alignment: Qt.AlignHCenter
+                Layout.preferredWidth: 250; Layout.preferredHeight: 60
+                background: Rectangle {
+                    color: parent.down ? "#aaaaaa" : "transparent"
+                    border.color: "#aaaaaa"; border.width: 2; radius: 30
+                }
+                contentItem: Text {
+                    text: parent.text; color: parent.down ? "white" : "#aaaaaa"
+                    font.pixelSize: 24; font.bold: true
+                    horizontalAlignment: Text.AlignHCenter; verticalAlignment: Text.AlignVCenter
+                }
+                onClicked: {
+                    window.settleAfterAdvance = false
+                    if (!backend.resumeSaved()) return;
                     mainScreen.visible = false;
                     gameScreen.visible = true
                 }
@@ -199,8 +206,8 @@ ApplicationWindow {
                                 tradeModal.stockPrice = model.price
                                 tradeModal.stockOwned = model.owned
                                 tradeModal.description = model.description
-                                tradeModal.priceHistory = backend.getStockHistory(index)
                                 tradeModal.tradeAmount = 1 // 팝업 열 때 1로 초기화
+                                tradeModal.limitPrice = Math.round(model.price)
                                 tradeModal.open()
                             }
                         }
@@ -208,24 +215,63 @@ ApplicationWindow {
                 }
             }
 
-            // (오른쪽) 뉴스 영역
-            Rectangle {
-                id: newsCard
+            // (오른쪽) 뉴스 + 미체결 주문
+            ColumnLayout {
                 Layout.fillHeight: true; Layout.fillWidth: true; Layout.preferredWidth: 1
-                color: "#f4f1ea"; radius: 2
-                border.color: newsMouseArea.containsMouse ? "#ff9800" : "transparent"
-                border.width: newsMouseArea.containsMouse ? 2 : 0
-                MouseArea {
-                    id: newsMouseArea; anchors.fill: parent; cursorShape: Qt.PointingHandCursor; hoverEnabled: true
-                    onClicked: newsDetailPopup.open()
+                spacing: 20
+
+                Rectangle {
+                    id: newsCard
+                    Layout.fillHeight: true; Layout.fillWidth: true
+                    color: "#f4f1ea"; radius: 2
+                    border.color: newsMouseArea.containsMouse ? "#ff9800" : "transparent"
+                    border.width: newsMouseArea.containsMouse ? 2 : 0
+                    MouseArea {
+                        id: newsMouseArea; anchors.fill: parent; cursorShape: Qt.PointingHandCursor; hoverEnabled: true
+                        onClicked: newsDetailPopup.open()
+                    }
+                    ColumnLayout {
+                        anchors.fill: parent; anchors.margins: 20; spacing: 10
+                        Text { text: "DAILY NEWS"; color: "#1a1a1a"; font.family: "Times New Roman"; font.pixelSize: 28; font.bold: true; Layout.alignment: Qt.AlignHCenter }
+                        Text { text: "(클릭해서 전체보기)"; color: "#555"; font.pixelSize: 12; Layout.alignment: Qt.AlignHCenter }
+                        Rectangle { height: 2; color: "black"; Layout.fillWidth: true }
+                        Text { text: window.newsTitle; color: "#1a1a1a"; font.bold: true; font.pixelSize: 20; Layout.topMargin: 10 }
+                        Text { text: window.newsBody; color: "#333"; font.pixelSize: 16; wrapMode: Text.WordWrap; Layout.fillWidth: true; Layout.fillHeight: true; elide: Text.ElideRight }
+                    }
                 }
-                ColumnLayout {
-                    anchors.fill: parent; anchors.margins: 20; spacing: 10
-                    Text { text: "DAILY NEWS"; color: "#1a1a1a"; font.family: "Times New Roman"; font.pixelSize: 28; font.bold: true; Layout.alignment: Qt.AlignHCenter }
-                    Text { text: "(클릭해서 전체보기)"; color: "#555"; font.pixelSize: 12; Layout.alignment: Qt.AlignHCenter }
-                    Rectangle { height: 2; color: "black"; Layout.fillWidth: true }
-                    Text { text: window.newsTitle; color: "#1a1a1a"; font.bold: true; font.pixelSize: 20; Layout.topMargin: 10 }
-                    Text { text: window.newsBody; color: "#333"; font.pixelSize: 16; wrapMode: Text.WordWrap; Layout.fillWidth: true; Layout.fillHeight: true; elide: Text.ElideRight }
+
+                // 미체결 지정가 주문 (있을 때만 표시)
+                Rectangle {
+                    Layout.fillWidth: true; Layout.preferredHeight: 200
+                    visible: backend.pendingOrders.length > 0
+                    color: "#2c2c2c"; radius: 10; border.color: "#333"
+                    ColumnLayout {
+                        anchors.fill: parent; anchors.margins: 15; spacing: 8
+                        Text { text: "⏳ 미체결 주문"; color: "white"; font.bold: true; font.pixelSize: 16 }
+                        ListView {
+                            Layout.fillWidth: true; Layout.fillHeight: true
+                            clip: true; spacing: 4
+                            model: backend.pendingOrders
+                            delegate: RowLayout {
+                                width: ListView.view.width; spacing: 10
+                                Text {
+                                    text: modelData.buy ? "매수" : "매도"
+                                    color: modelData.buy ? window.colorUp : window.colorDown; font.bold: true
+                                }
+                                Text { text: modelData.name; color: "white"; Layout.fillWidth: true; elide: Text.ElideRight }
+                                Text {
+                                    text: modelData.price.toLocaleString(Qt.locale(), 'f', 0) + "원 × " + modelData.remaining + "/" + modelData.quantity + "주"
+                                    color: "#aaa"
+                                }
+                                Button {
+                                    text: "취소"
+                                    background: Rectangle { color: "#444"; radius: 4 }
+                                    contentItem: Text { text: parent.text; color: "white"; horizontalAlignment: Text.AlignHCenter }
+                                    onClicked: backend.cancelOrder(modelData.id)
+                                }
+                            }
+                        }
+                    }
                 }
             }
         }
@@ -248,9 +294,9 @@ ApplicationWindow {
                     Text { text: "하루 마감 및 정산"; color: "white"; font.bold: true; font.pixelSize: 16;Layout.alignment: Qt.AlignCenter }
                 }
                 onClicked: {
-                    if (day > window.maxDay) return;
-                    loadingOverlay.visible = true
-                    simulationTimer.start()
+                    if (day > window.maxDay || backend.busy) return;
+                    window.settleAfterAdvance = true
+                    backend.advanceDays(1)
                 }
             }
         }
@@ -259,7 +305,7 @@ ApplicationWindow {
     // --- 주식 거래 팝업 (차트 및 버튼 수정됨) ---
     Popup {
         id: tradeModal
-        anchors.centerIn: parent; width: 600; height: 600
+        anchors.centerIn: parent; width: 600; height: 690
         modal: true; focus: true
         closePolicy: Popup.CloseOnEscape | Popup.CloseOnPressOutside
 
@@ -267,15 +313,23 @@ ApplicationWindow {
         property string stockName: ""
         property double stockPrice: 0
         property int stockOwned: 0
-        property var priceHistory: []
         property int tradeAmount: 1
+        property double limitPrice: 0
+        property var indicators: ({})
+        property bool showAverages: true
         onOpened: {
+                    indicators = backend.indicators(stockIndex)
                     tradeAmount = 1
                     if (amountSpin) {
                         amountSpin.value = 1
                     }
                 }
         property string description: ""
+        // 체결/턴 진행으로 값이 바뀌면 다시 읽음
+        Connections {
+            target: backend
+            function onDataChanged() { if (tradeModal.opened) tradeModal.indicators = backend.indicators(tradeModal.stockIndex) }
+        }
 
         background: Rectangle { color: "#2c2c2c"; border.color: "#555"; radius: 10 }
         contentItem: Item {
@@ -291,60 +345,93 @@ ApplicationWindow {
                 Text { text: tradeModal.stockName; color: "white"; font.pixelSize: 24; font.bold: true; Layout.alignment: Qt.AlignHCenter }
                 Text { text: tradeModal.description; color: "white"; font.pixelSize: 18; Layout.alignment: Qt.AlignCenter; wrapMode:Text.WordWrap
                 Layout.fillWidth: true;Layout.maximumWidth: parent.width -50}
-                // 차트 영역
+                // 차트 영역 (C++ PriceChart가 백엔드 history를 직접 그림)
                 Rectangle {
                     Layout.fillWidth: true; Layout.preferredHeight: 250; color: "#222"; border.color: "#444"; clip: true
-                    Canvas {
-                        id: stockChart; anchors.fill: parent; antialiasing: true
-                        onPaint: {
-                            var ctx = getContext("2d");
-                            ctx.clearRect(0, 0, width, height);
-                            var data = tradeModal.priceHistory;
-                            if (!data || data.length < 1) {
-                                ctx.fillStyle = "#aaa"; ctx.textAlign = "center"; ctx.fillText("데이터 부족", width/2, height/2); return;
-                            }
-                            var padLeft=45, padRight=30, padTop=30, padBottom=30;
-                            var graphW = width - padLeft - padRight;
-                            var graphH = height - padTop - padBottom;
-                            var minVal = data[0], maxVal = data[0];
-                            for (var i=1; i<data.length; i++) { if(data[i]<minVal) minVal=data[i]; if(data[i]>maxVal) maxVal=data[i]; }
-                            var range = maxVal - minVal;
-                            if (range === 0) { range = maxVal * 0.1; minVal -= range; maxVal += range; range = maxVal - minVal; }
-                            else { var buffer = range * 0.1; minVal -= buffer; maxVal += buffer; range = maxVal - minVal; }
-
-                            ctx.lineWidth = 1; ctx.strokeStyle = "#444"; ctx.beginPath();
-                            ctx.moveTo(padLeft, padTop); ctx.lineTo(padLeft, height - padBottom); ctx.lineTo(width - padRight, height - padBottom); ctx.stroke();
-
-                            ctx.beginPath(); ctx.lineWidth = 2; ctx.strokeStyle = window.colorUp;
-                            var stepX = (data.length > 1) ? graphW / (data.length - 1) : graphW;
-                            for (var j=0; j<data.length; j++) {
-                                var x = padLeft + (j * stepX);
-                                var y = (height - padBottom) - ((data[j] - minVal) / range) * graphH;
-                                if (j === 0) ctx.moveTo(x, y); else ctx.lineTo(x, y);
+                    // 축
+                    Rectangle { x: 45; y: 30; width: 1; height: parent.height - 60; color: "#444" }
+                    Rectangle { x: 45; y: parent.height - 30; width: parent.width - 75; height: 1; color: "#444" }
+                    PriceChart {
+                        id: stockChart
+                        anchors.fill: parent
+                        anchors.leftMargin: 45; anchors.rightMargin: 30; anchors.topMargin: 30; anchors.bottomMargin: 30
+                        source: backend
+                        stockIndex: tradeModal.stockIndex
+                        lineColor: window.colorUp
+                        downColor: window.colorDown
+                        style: backend.intradayBarCount > 0 ? chartStyle.current : PriceChart.Line
+                        showAverages: tradeModal.showAverages
+
+                        // 장중 봉은 하루가 지나면 앞에서부터 차례로 그려서 장이 흘러가는 것처럼 보여줌
+                        NumberAnimation on visibleBars {
+                            id: intradayReveal
+                            running: false
+                            from: 0; to: backend.intradayBarCount
+                            duration: 1500
+                        }
+                        Connections {
+                            target: backend
+                            function onAdvanceFinished() {
+                                if (tradeModal.opened && stockChart.style === PriceChart.Intraday) intradayReveal.restart()
                             }
-                            ctx.stroke();
-
-                            ctx.font = "12px sans-serif";
-                            for (var k=0; k<data.length; k++) {
-                                var px = padLeft + (k * stepX);
-                                var pVal = data[k];
-                                var py = (height - padBottom) - ((pVal - minVal) / range) * graphH;
-                                ctx.beginPath(); ctx.arc(px, py, 3, 0, 2*Math.PI); ctx.fillStyle = window.colorUp; ctx.fill();
-                                if (k === 0) ctx.textAlign = "left"; else if (k === data.length - 1) ctx.textAlign = "right"; else ctx.textAlign = "center";
-                                ctx.fillStyle = "#fff";
-                                ctx.fillText(pVal.toFixed(0), px, py - 10);
-                                ctx.fillStyle = "#aaa";
-
-                                // 현재 화면에 표시되는 날짜(window.day - 1)를 기준으로 역산하여 차트 라벨을 매칭
-                                var currentVisualDay = window.day - 1;
-                                var dayLabelVal = currentVisualDay - (data.length - 1) + k;
-                                var dayLabel = "D" + dayLabelVal;
-
-                                ctx.fillText(dayLabel, px, height - padBottom + 15);
+                        }
+                    }
+                    // 차트 종류 (장중 모드일 때만)
+                    Row {
+                        id: chartStyle
+                        property int current: PriceChart.Candles
+                        visible: backend.intradayBarCount > 0
+                        anchors.horizontalCenter: parent.horizontalCenter; anchors.top: parent.top; anchors.topMargin: 4
+                        spacing: 4
+                        Repeater {
+                            model: [ { label: "선", value: PriceChart.Line }, { label: "일봉", value: PriceChart.Candles }, { label: "장중", value: PriceChart.Intraday } ]
+                            delegate: Button {
+                                width: 44; height: 22
+                                background: Rectangle { color: chartStyle.current === modelData.value ? "#555" : "#333"; radius: 4 }
+                                contentItem: Text { text: modelData.label; color: "white"; font.pixelSize: 11; horizontalAlignment: Text.AlignHCenter; verticalAlignment: Text.AlignVCenter }
+                                onClicked: {
+                                    chartStyle.current = modelData.value
+                                    stockChart.visibleBars = -1
+                                }
                             }
                         }
                     }
-                    Connections { target: tradeModal; function onPriceHistoryChanged() { stockChart.requestPaint(); } }
+                    Text {
+                        visible: stockChart.pointCount < 1
+                        anchors.centerIn: parent; text: "데이터 부족"; color: "#aaa"
+                    }
+                    // 최고/최저/현재가 라벨
+                    Text {
+                        visible: stockChart.pointCount > 0
+                        anchors.left: parent.left; anchors.leftMargin: 50; anchors.top: parent.top; anchors.topMargin: 8
+                        text: "최고 " + stockChart.maxPrice.toFixed(0) + "  최저 " + stockChart.minPrice.toFixed(0)
+                        color: "#aaa"; font.pixelSize: 12
+                    }
+                    Text {
+                        visible: stockChart.pointCount > 0
+                        anchors.right: parent.right; anchors.rightMargin: 30; anchors.top: parent.top; anchors.topMargin: 8
+                        text: stockChart.lastPrice.toFixed(0); color: "#fff"; font.pixelSize: 12
+                    }
+                    // 이동평균 오버레이 켜기/끄기 (선 차트에서만, 색은 PriceChart의 평균선 색과 같음)
+                    Button {
+                        visible: stockChart.style === PriceChart.Line && tradeModal.indicators.sma !== undefined
+                        anchors.right: parent.right; anchors.rightMargin: 4; anchors.bottom: parent.bottom; anchors.bottomMargin: 32
+                        width: 44; height: 22
+                        background: Rectangle { color: tradeModal.showAverages ? "#555" : "#333"; radius: 4 }
+                        contentItem: Text { text: "평균"; color: "white"; font.pixelSize: 11; horizontalAlignment: Text.AlignHCenter; verticalAlignment: Text.AlignVCenter }
+                        onClicked: tradeModal.showAverages = !tradeModal.showAverages
+                    }
+                    // 현재 화면에 표시되는 날짜(window.day - 1)를 기준으로 첫/마지막 날짜 라벨
+                    Text {
+                        visible: stockChart.pointCount > 0
+                        x: 45; anchors.bottom: parent.bottom; anchors.bottomMargin: 10
+                        text: "D" + ((window.day - 1) - (stockChart.pointCount - 1)); color: "#aaa"; font.pixelSize: 12
+                    }
+                    Text {
+                        visible: stockChart.pointCount > 1
+                        anchors.right: parent.right; anchors.rightMargin: 30; anchors.bottom: parent.bottom; anchors.bottomMargin: 10
+                        text: "D" + (window.day - 1); color: "#aaa"; font.pixelSize: 12
+                    }
                 }
 
                 RowLayout {
@@ -354,6 +441,27 @@ ApplicationWindow {
                     Text { text: "보유: " + tradeModal.stockOwned + "주"; color: "#aaa" }
                 }
 
+                // 보조 지표 (백엔드가 종가마다 누적값으로 갱신)
+                RowLayout {
+                    Layout.fillWidth: true
+                    visible: tradeModal.indicators.sma !== undefined
+                    spacing: 12
+                    Text {
+                        text: "SMA" + tradeModal.indicators.smaWindow + " " + Number(tradeModal.indicators.sma).toFixed(0)
+                        color: "#ffb74d"; font.pixelSize: 12
+                    }
+                    Text {
+                        text: "EMA" + tradeModal.indicators.emaPeriod + " " + Number(tradeModal.indicators.ema).toFixed(0)
+                        color: "#4dd0e1"; font.pixelSize: 12
+                    }
+                    Text { text: "RSI " + Number(tradeModal.indicators.rsi).toFixed(0); color: "#aaa"; font.pixelSize: 12 }
+                    Text { text: "변동성 " + Number(tradeModal.indicators.volatility).toFixed(1) + "%"; color: "#aaa"; font.pixelSize: 12 }
+                    Text {
+                        text: "낙폭 " + Number(tradeModal.indicators.drawdown).toFixed(1) + "% (최대 " + Number(tradeModal.indicators.maxDrawdown).toFixed(1) + "%)"
+                        color: "#aaa"; font.pixelSize: 12
+                    }
+                }
+
                 Rectangle { Layout.fillWidth: true; height: 1; color: "#444" }
 
                 // [수정] 수량 조절 (+ - 버튼 추가) 및 최대 버튼
@@ -425,6 +533,42 @@ ApplicationWindow {
                     font.bold: true; font.pixelSize: 16; Layout.alignment: Qt.AlignRight
                 }
 
+                // 지정가 주문 (남은 수량은 주가가 지정가에 닿을 때까지 주문장에 남음)
+                RowLayout {
+                    Layout.fillWidth: true; spacing: 10
+                    Text { text: "지정가:"; color: "white"; font.pixelSize: 16 }
+                    TextField {
+                        Layout.preferredWidth: 140
+                        text: tradeModal.limitPrice.toFixed(0)
+                        color: "white"; horizontalAlignment: Qt.AlignHCenter
+                        validator: IntValidator { bottom: 1 }
+                        inputMethodHints: Qt.ImhDigitsOnly
+                        background: Rectangle { color: "#333"; border.color: "#555"; radius: 4 }
+                        onEditingFinished: tradeModal.limitPrice = Number(text)
+                    }
+                    Item { Layout.fillWidth: true }
+                    Button {
+                        text: "지정가 매수"
+                        enabled: tradeModal.limitPrice > 0 && window.cash >= tradeModal.limitPrice * tradeModal.tradeAmount
+                        background: Rectangle { color: "#333"; border.color: parent.enabled ? window.colorUp : "#555"; radius: 4 }
+                        contentItem: Text { text: parent.text; color: parent.enabled ? window.colorUp : "#aaa" }
+                        onClicked: {
+                            backend.placeLimitOrder(tradeModal.stockIndex, true, tradeModal.limitPrice, tradeModal.tradeAmount);
+                            tradeModal.close();
+                        }
+                    }
+                    Button {
+                        text: "지정가 매도"
+                        enabled: tradeModal.limitPrice > 0 && tradeModal.stockOwned >= tradeModal.tradeAmount
+                        background: Rectangle { color: "#333"; border.color: parent.enabled ? window.colorDown : "#555"; radius: 4 }
+                        contentItem: Text { text: parent.text; color: parent.enabled ? window.colorDown : "#aaa" }
+                        onClicked: {
+                            backend.placeLimitOrder(tradeModal.stockIndex, false, tradeModal.limitPrice, tradeModal.tradeAmount);
+                            tradeModal.close();
+                        }
+                    }
+                }
+
                 // 매수/매도 버튼
                 RowLayout {
                     Layout.fillWidth: true; spacing: 10
@@ -472,8 +616,8 @@ ApplicationWindow {
         id: newsDetailPopup
         anchors.centerIn: parent; width: 800; height: 600; modal: true; focus: true
         closePolicy: Popup.CloseOnEscape | Popup.CloseOnPressOutside
-        property int viewingIndex: newsHistoryModel.count - 1
-        onOpened: viewingIndex = newsHistoryModel.count - 1
+        property int viewingIndex: window.newsModel.count - 1
+        onOpened: viewingIndex = window.newsModel.count - 1
         background: Rectangle { color: "#f4f1ea"; border.color: "#333"; border.width: 2 }
         contentItem: Item {
             anchors.fill: parent
@@ -489,7 +633,7 @@ ApplicationWindow {
                 Rectangle {
                     Layout.fillWidth: true; height: 50; color: "transparent"
                     ListView {
-                        anchors.fill: parent; orientation: ListView.Horizontal; spacing: 10; model: newsHistoryModel; clip: true
+                        anchors.fill: parent; orientation: ListView.Horizontal; spacing: 10; model: window.newsModel; clip: true
                         delegate: Button {
                             width: 80; height: 40; background: Rectangle { color: index === newsDetailPopup.viewingIndex ? "#111" : "#ddd"; radius: 5 }
                             contentItem: Text { text: model.dayIdx + "일차"; color: index === newsDetailPopup.viewingIndex ? "white" : "black"; horizontalAlignment: Text.AlignHCenter; verticalAlignment: Text.AlignVCenter }
@@ -504,8 +648,10 @@ ApplicationWindow {
                         readOnly: true; textFormat: Text.RichText; color: "#111"; background: null; font.family: "Times New Roman"
                         // [수정] \n을 <br>로 치환하여 줄바꿈 적용
                         text: {
-                            var item = newsHistoryModel.get(newsDetailPopup.viewingIndex);
-                            return item ? "<h3>" + item.title + "</h3><br><p style='font-size:18px'>" + item.body.replace(/\n/g, "<br>") + "</p>" : ""
+                            var i = newsDetailPopup.viewingIndex
+                            if (i < 0 || i >= window.newsModel.count) return ""
+                            return "<h3>" + window.newsModel.title(i) + "</h3><br><p style='font-size:18px'>"
+                                   + window.newsModel.body(i).replace(/\n/g, "<br>") + "</p>"
                         }
                     }
                 }
@@ -606,27 +752,61 @@ ApplicationWindow {
         }
     }
 
+    // --- 프로파일 오버레이 (F3, STOCKGAME_PROFILE 빌드에서만 값이 있음) ---
+    Shortcut { sequence: "F3"; onActivated: profileOverlay.shown = !profileOverlay.shown }
+    Rectangle {
+        id: profileOverlay
+        property bool shown: false
+        property var profile: backend.profile
+        visible: shown; z: 90
+        anchors.right: parent.right; anchors.bottom: parent.bottom; anchors.margins: 10
+        width: 420; height: profileColumn.implicitHeight + 20
+        color: "#dd000000"; radius: 6; border.color: "#555"
+        Column {
+            id: profileColumn
+            anchors.fill: parent; anchors.margins: 10; spacing: 2
+            Text {
+                text: profileOverlay.profile.enabled ? "프로파일 (" + profileOverlay.profile.turns + "턴, 단위 µs)"
+                                                     : "프로파일 꺼짐 (STOCKGAME_PROFILE로 빌드하세요)"
+                color: "#ff9800"; font.pixelSize: 13; font.bold: true
+            }
+            Repeater {
+                model: profileOverlay.profile.enabled ? profileOverlay.profile.phases : []
+                Text {
+                    text: modelData.name + "  직전 " + modelData.lastUs.toFixed(1) + " (" + modelData.lastCalls + "회)"
+                          + "  평균 " + modelData.avgUs.toFixed(1) + "  최대 " + modelData.maxUs.toFixed(1)
+                    color: "#ddd"; font.pixelSize: 12; font.family: "monospace"
+                }
+            }
+            Repeater {
+                model: profileOverlay.profile.enabled ? profileOverlay.profile.counters : []
+                Text {
+                    text: modelData.name + "  직전 " + modelData.last + "  누적 " + modelData.total
+                    color: "#aaa"; font.pixelSize: 12; font.family: "monospace"
+                }
+            }
+            Button {
+                visible: profileOverlay.profile.enabled
+                text: "트레이스 저장 (trace.json)"
+                onClicked: backend.saveTrace("trace.json")
+            }
+        }
+    }
+
     // --- 로딩 오버레이 ---
     Rectangle {
         id: loadingOverlay
-        anchors.fill: parent; color: "#cc000000"; visible: false; z: 100
+        anchors.fill: parent; color: "#cc000000"; visible: backend.busy; z: 100
         MouseArea { anchors.fill: parent }
         Column {
             anchors.centerIn: parent; spacing: 20
             BusyIndicator { running: loadingOverlay.visible; width: 60; height: 60; palette.dark: window.colorUp }
             Text { text: "시장 데이터 정산 중..."; color: "white"; font.pixelSize: 20; font.bold: true }
-        }
-    }
-
-    // --- 시뮬레이션 타이머 ---
-    Timer {
-        id: simulationTimer
-        interval: 1000; repeat: false
-        onTriggered: {
-            loadingOverlay.visible = false
-            backend.nextTurn()
-            if (window.day <= window.maxDay) {
-                settlementPopup.open()
+            // 여러 날을 진행할 때만 진행률 표시
+            Text {
+                visible: backend.progressTotal > 1
+                text: backend.progressDone + " / " + backend.progressTotal + "일"
+                color: "#aaa"; font.pixelSize: 16; anchors.horizontalCenter: parent.horizontalCenter
             }
         }
     }
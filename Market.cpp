@@ -0,0 +1,875 @@
+﻿#include "Market.h"
+#include "BitSet.h"
+#include "PriceKernel.h"
+#include "Profiler.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+Market::Market(uint64_t seed) : Market(Scenario::builtin(), seed) {}
+
+Market::Market(shared_ptr<const Scenario> scenario, uint64_t seed) : m_scenario(move(scenario)), m_seed(seed) {
+    m_cash = m_totalAsset = m_prevAsset = m_scenario->startCash();
+    resetState();
+    calculateTotalAsset();
+}
+
+double Market::changeRate(int index) const {
+    const PriceHistory& history = m_history[index];
+    double rate = 0.0;
+    if(history.size() >= 2) {
+        double yesterday = history[history.size() - 2];
+        if(yesterday != 0)
+            rate = ((m_finalPrice[index] - yesterday) / yesterday) * 100.0;
+    }
+    return rate;
+}
+
+bool Market::buyStock(int index, int amount) {
+    if(index < 0 || index >= companyCount() || amount <= 0) return false;
+    //매도 호가를 싼 것부터 훑되 현금이 닿는 만큼만
+    const int64_t budget = (int64_t)floor(m_cash);
+    OrderBook::Result r = bookFor(index).submitMarket(OrderBook::Buy, amount,
+        [this](const OrderBook::Fill& f) { settleMakerFill(f); }, budget);
+    if(r.filled == 0) return false;
+    m_cash -= (double)r.cost;
+    m_amount[index] += (int)r.filled;
+    applyTradePrice(index, r.lastPrice, r.filled);
+    calculateTotalAsset();
+    return true;
+}
+
+bool Market::sellStock(int index, int amount) {
+    if(index < 0 || index >= companyCount() || amount <= 0) return false;
+    if(m_amount[index] < amount) return false;
+    OrderBook::Result r = bookFor(index).submitMarket(OrderBook::Sell, amount,
+        [this](const OrderBook::Fill& f) { settleMakerFill(f); });
+    if(r.filled == 0) return false;
+    m_cash += (double)r.cost;
+    m_amount[index] -= (int)r.filled;
+    applyTradePrice(index, r.lastPrice, r.filled);
+    calculateTotalAsset();
+    return true;
+}
+
+uint32_t Market::placeLimitOrder(int index, bool buy, double price, int amount) {
+    if(index < 0 || index >= companyCount() || amount <= 0) return 0;
+    const int64_t limit = llround(price);
+    if(limit <= 0) return 0;
+    //주문이 남아 있는 동안 쓸 현금/주식을 미리 묶어 둠
+    if(buy) {
+        if(m_cash < (double)limit * amount) return 0;
+        m_cash -= (double)limit * amount;
+    } else {
+        if(m_amount[index] < amount) return 0;
+        m_amount[index] -= amount;
+    }
+
+    const uint32_t id = m_nextOrderId++;
+    OrderBook::Result r = bookFor(index).submitLimit(buy ? OrderBook::Buy : OrderBook::Sell, limit, amount, id,
+        [this](const OrderBook::Fill& f) { settleMakerFill(f); });
+    if(r.filled > 0) {
+        if(buy) {
+            //지정가보다 싸게 체결된 차액은 돌려받음
+            m_amount[index] += (int)r.filled;
+            m_cash += (double)(limit * r.filled - r.cost);
+        } else {
+            m_cash += (double)r.cost;
+        }
+        applyTradePrice(index, r.lastPrice, r.filled);
+    }
+    if(r.resting != OrderBook::NoOrder)
+        m_orders.push_back({id, index, buy, limit, amount, amount - (int)r.filled, r.resting});
+    calculateTotalAsset();
+    return id;
+}
+
+bool Market::cancelOrder(uint32_t id) {
+    PendingOrder* order = findOrder(id);
+    if(!order) return false;
+    int64_t remaining = 0;
+    m_books[m_bookOf[order->company]].cancel(order->bookOrder, &remaining);
+    if(order->buy) m_cash += (double)(order->price * remaining);
+    else m_amount[order->company] += (int)remaining;
+    m_orders.erase(m_orders.begin() + (order - m_orders.data()));
+    calculateTotalAsset();
+    return true;
+}
+
+PendingOrder* Market::findOrder(uint32_t id) {
+    auto it = lower_bound(m_orders.begin(), m_orders.end(), id,
+                          [](const PendingOrder& o, uint32_t v) { return o.id < v; });
+    return (it != m_orders.end() && it->id == id) ? &*it : nullptr;
+}
+
+//주문장에 있던 플레이어 주문이 체결됨 (시장 조성 호가는 정산할 것이 없음)
+void Market::settleMakerFill(const OrderBook::Fill& fill) {
+    if(fill.makerOwner == MakerOwner) return;
+    PendingOrder* order = findOrder(fill.makerOwner);
+    if(!order) return;
+    if(order->buy) {
+        m_amount[order->company] += (int)fill.quantity;
+        m_cash += (double)((order->price - fill.price) * fill.quantity);
+    } else {
+        m_cash += (double)(fill.price * fill.quantity);
+    }
+    order->remaining -= (int)fill.quantity;
+    if(fill.makerDone) m_orders.erase(m_orders.begin() + (order - m_orders.data()));
+}
+
+//마지막 체결가를 현재가로 (기준가도 같은 비율로 움직여서 다음 날 계산에 이어짐)
+void Market::applyTradePrice(int company, int64_t price, int64_t quantity) {
+    const double last = (double)price;
+    if(m_finalPrice[company] > 0) m_basePrice[company] *= last / m_finalPrice[company];
+    m_finalPrice[company] = last;
+    m_history[company].setBack(last);
+    if(m_indicators.enabled()) m_indicators.revise(company, last);
+    //장중 모드면 오늘 봉(일봉과 마지막 장중 봉)에도 체결을 반영
+    if(!m_candles[company].empty()) {
+        Bar* bars[2] = { &m_candles[company].back(), nullptr };
+        if(m_intraday.barsPerDay() > 0) bars[1] = &m_bars[(size_t)(company + 1) * m_intraday.barsPerDay() - 1];
+        for(Bar* b : bars) {
+            if(!b) continue;
+            b->high = max(b->high, last);
+            b->low = min(b->low, last);
+            b->close = last;
+            b->volume += (double)quantity;
+        }
+    }
+}
+
+void Market::setIntraday(const IntradayConfig& config) {
+    IntradayConfig c = config;
+    c.ticks = clamp(c.ticks, 0, 100000);
+    c.ticksPerBar = max(1, c.ticks > 0 ? min(c.ticksPerBar, c.ticks) : c.ticksPerBar);
+    if(c == m_intraday) return;
+    m_intraday = c;
+    const size_t companies = m_history.size();
+    m_bars.assign(companies * c.barsPerDay(), Bar{});
+    //설정이 바뀌면 일봉도 새로 쌓음 (끄면 비움)
+    m_candles.assign(companies, {});
+}
+
+void Market::setIndicators(const IndicatorConfig& config) {
+    if(config == m_indicators.config()) return;
+    m_indicators.configure(config, m_history);
+}
+
+OrderBook& Market::bookFor(int company) {
+    int& slot = m_bookOf[company];
+    if(slot < 0) {
+        if(m_freeBooks.empty()) {
+            m_freeBooks.push_back((int)m_books.size());
+            m_books.emplace_back();
+            m_bookCompany.push_back(-1);
+        }
+        slot = m_freeBooks.back();
+        m_freeBooks.pop_back();
+        m_bookCompany[slot] = company;
+        seedLiquidity(m_books[slot], company);
+    }
+    return m_books[slot];
+}
+
+//시장 조성 호가: 현재가 바로 위/아래부터 BookStep 간격으로 BookLevels개씩
+//물량은 (시드, 날짜, 회사) 난수로 정하므로 같은 날 같은 회사의 주문장은 언제 만들어도 같습니다.
+void Market::makerLevels(uint64_t seed, int day, int company, double price, MakerLevel* asks, MakerLevel* bids) {
+    RandomStream rng(seed, RandomStream::Liquidity, (uint32_t)day, (uint32_t)company);
+    const int64_t step = max<int64_t>(1, llround(price * BookStep));
+    const int64_t ask = max<int64_t>(1, (int64_t)ceil(price));
+    const int64_t bid = min<int64_t>((int64_t)floor(price), ask - 1);
+    for(int k = BookLevels - 1; k >= 0; k--) {
+        const double depth = LevelDepth * (1.0 + 0.5 * k) / max(price, 1.0);
+        const int64_t askQty = max<int64_t>(1, llround(depth * rng.random_num(80, 120) / 100.0));
+        const int64_t bidQty = max<int64_t>(1, llround(depth * rng.random_num(80, 120) / 100.0));
+        asks[k] = { ask + k * step, askQty };
+        bids[k] = { bid - k * step, (bid - k * step > 0) ? bidQty : 0 };
+    }
+}
+
+void Market::seedLiquidity(OrderBook& book, int company) {
+    MakerLevel asks[BookLevels], bids[BookLevels];
+    makerLevels(m_seed, m_day, company, m_finalPrice[company], asks, bids);
+    //먼 호가부터 올려서 새 레벨이 항상 배열 끝(최우선 쪽)에 붙도록
+    for(int k = BookLevels - 1; k >= 0; k--) {
+        book.rest(OrderBook::Sell, asks[k].price, asks[k].quantity, MakerOwner);
+        if(bids[k].quantity > 0) book.rest(OrderBook::Buy, bids[k].price, bids[k].quantity, MakerOwner);
+    }
+}
+
+//하루가 지나면 주문장을 모두 돌려받고, 미체결 주문은 주문 순서대로 새 호가에 다시 넣습니다.
+//(주가가 지정가를 넘어 움직였으면 새 호가 가격에 체결되고, 주문 사이의 시간 우선순위는 그대로)
+void Market::rollBooks() {
+    for(size_t b = 0; b < m_books.size(); b++) {
+        if(m_bookCompany[b] < 0) continue;
+        m_books[b].clear();
+        m_bookOf[m_bookCompany[b]] = -1;
+        m_bookCompany[b] = -1;
+        m_freeBooks.push_back((int)b);
+    }
+    if(m_orders.empty()) return;
+
+    vector<PendingOrder> orders;
+    orders.swap(m_orders);
+    for(const PendingOrder& o : orders) {
+        OrderBook::Result r = bookFor(o.company).submitLimit(o.buy ? OrderBook::Buy : OrderBook::Sell, o.price, o.remaining,
+            o.id, [this](const OrderBook::Fill& f) { settleMakerFill(f); });
+        if(r.filled > 0) {
+            if(o.buy) {
+                m_amount[o.company] += (int)r.filled;
+                m_cash += (double)(o.price * r.filled - r.cost);
+            } else {
+                m_cash += (double)r.cost;
+            }
+            applyTradePrice(o.company, r.lastPrice, r.filled);
+        }
+        if(r.resting != OrderBook::NoOrder)
+            m_orders.push_back({o.id, o.company, o.buy, o.price, o.quantity, o.remaining - (int)r.filled, r.resting});
+    }
+}
+
+void Market::nextTurn() {
+    if(isOver()) return;
+    PROFILE_SCOPE(m_profiler, Turn);
+    m_prevAsset = m_totalAsset;
+
+    TickCooldowns();
+    UpdateEffects();
+    ProcessEvents();
+    CalculatePrices();
+
+    m_day++;
+    rollBooks();
+    calculateTotalAsset();
+}
+
+void Market::TickCooldowns() {
+    PROFILE_SCOPE(m_profiler, TickCooldowns);
+    for(int& cooldown : m_cooldown) {
+        if(cooldown > 0) cooldown--;
+    }
+}
+
+ActiveEffect* Market::CheckEffect(int company, int effectId) {
+    //비트셋으로 먼저 걸러서 대부분의 경우 목록을 훑지 않음
+    if (!bits::test(&m_activeEffectBits[(size_t)company * m_effectWords], effectId)) return nullptr;
+    for (auto& e : m_effects[company]) { if (e.id == effectId) return &e; }
+    return nullptr;
+}
+
+void Market::AddEffect(int company, int effectId) {
+    const sgsc::EffectRecord& baseEffect = m_scenario->effect(effectId);
+    if (ActiveEffect* eff = CheckEffect(company, effectId)) { eff->duration = baseEffect.duration; return; }
+    m_effects[company].push_back({effectId, baseEffect.impact, baseEffect.duration, false});
+    PROFILE_COUNT(m_profiler, EffectsAdded, 1);
+    m_impactSum[company] += baseEffect.impact;
+    bits::set(&m_activeEffectBits[(size_t)company * m_effectWords], effectId);
+}
+
+void Market::UpdateEffects() {
+    PROFILE_SCOPE(m_profiler, UpdateEffects);
+    const size_t companies = m_history.size();
+    for (size_t c = 0; c < companies; c++) {
+        vector<ActiveEffect>& effects = m_effects[c];
+        for (int i = effects.size() - 1; i >= 0; i--) {
+
+            effects[i].duration--;
+
+            // 지속시간이 끝난 경우
+            if (effects[i].duration <= 0) {
+
+                // 아직 반전되지 않은 효과라면 → 반전 처리
+                if (!effects[i].reversed) {
+
+                    // impact 반전 (합계에서 기존 값을 빼고 반전된 값을 더함)
+                    m_impactSum[c] -= 2 * effects[i].impact;
+                    effects[i].impact = -effects[i].impact;
+                    effects[i].reversed = true;
+                    PROFILE_COUNT(m_profiler, EffectsReversed, 1);
+
+                    // 초기 지속시간으로 재적용
+                    effects[i].duration = m_scenario->effect(effects[i].id).duration;
+                }
+                else {
+                    // 이미 반전된 효과인데 지속시간까지 끝났다면 → 최종 삭제
+                    m_impactSum[c] -= effects[i].impact;
+                    bits::clear(&m_activeEffectBits[c * m_effectWords], effects[i].id);
+                    effects.erase(effects.begin() + i);
+                    PROFILE_COUNT(m_profiler, EffectsErased, 1);
+                }
+            }
+        }
+    }
+}
+
+void Market::CalculatePrices() {
+    PROFILE_SCOPE(m_profiler, CalculatePrices);
+    const size_t companies = m_history.size();
+    m_minorDraw.resize(companies);
+    m_buffDraw.resize(companies);
+    m_noiseDraw.resize(companies);
+
+    //회사마다 (시드, 날짜, 회사) 난수열이 따로 있으므로 구간을 나눠 병렬로 돌려도 결과가 같습니다.
+    auto step = [this](size_t begin, size_t end) {
+        //1단계: 회사별 난수 뽑기
+        for (size_t c = begin; c < end; c++) {
+            RandomStream rng(m_seed, RandomStream::Price, (uint32_t)m_day, (uint32_t)c);
+            //현재 기업이 가진 모든 버프/디버프 영향력 합계
+            int value = m_impactSum[c];
+
+            //소폭 변동(기준가에 적용)
+            m_minorDraw[c] = rng.roll(50) ? 1.02 : 0.98;
+
+            //이벤트 영향 적용(기준가 적용)
+            double buffChangePercent = 0.0;
+            if (value > 0) {
+                if (rng.roll(90)) buffChangePercent = rng.random_num(0, value) / 100.0;
+                else buffChangePercent = -(rng.random_num(0, value/2) / 100.0);
+            } else if (value < 0) {
+                int v = abs(value);
+                if (rng.roll(90)) buffChangePercent = -(rng.random_num(0, v) / 100.0);
+                else buffChangePercent = (rng.random_num(0, v/2) / 100.0);
+            }
+            m_buffDraw[c] = buffChangePercent;
+
+            //노이즈(최종가 적용,95%~105%)
+            m_noiseDraw[c] = rng.random_num(95, 105) / 100.0;
+        }
+
+        //2단계: 구간 전체 주가를 한 번에 갱신 (SIMD 커널)
+        applyPriceStep(m_basePrice.data() + begin, m_finalPrice.data() + begin,
+                       m_minorDraw.data() + begin, m_buffDraw.data() + begin, m_noiseDraw.data() + begin, end - begin);
+
+        //장중 모드: 전날 종가 → 오늘 종가 틱 경로를 봉으로 합침 (회사마다 별도 난수열이라 병렬로 돌려도 같음)
+        if (const int barsPerDay = m_intraday.barsPerDay()) {
+            static thread_local vector<double> scratch;
+            scratch.resize(m_intraday.ticks);
+            for (size_t c = begin; c < end; c++) {
+                RandomStream rng(m_seed, RandomStream::Intraday, (uint32_t)m_day, (uint32_t)c);
+                Bar day;
+                simulateIntradayDay(m_intraday, rng, m_history[c].back(), m_finalPrice[c], scratch.data(),
+                                    &m_bars[c * barsPerDay], day);
+                m_candles[c].push_back(day);
+            }
+        }
+
+        for (size_t c = begin; c < end; c++) m_history[c].push(m_finalPrice[c]);
+        if (m_indicators.enabled())
+            for (size_t c = begin; c < end; c++) m_indicators.push(c, m_finalPrice[c]);
+    };
+
+    if (m_pool && companies >= ParallelThreshold) m_pool->parallelFor(0, companies, ParallelGrain, step);
+    else step(0, companies);
+}
+
+void Market::ProcessEvents() {
+    PROFILE_SCOPE(m_profiler, ProcessEvents);
+    const Scenario& scenario = *m_scenario;
+    vector<NewsItem>& finalNews = m_todayNews;
+    finalNews.clear();
+    m_firedEvents.clear();
+    //발생 여부 판정(모든 이벤트 순회)
+    for (size_t e = 0; e < m_cooldown.size(); e++) {
+        const sgsc::EventRecord& event = scenario.event((int)e);
+        //이벤트 쿨타임 체크
+        if(m_cooldown[e] > 0) continue;
+        //이벤트마다 독립된 난수열 (이벤트를 추가/삭제해도 다른 이벤트의 결과는 그대로)
+        RandomStream rng(m_seed, RandomStream::Events, (uint32_t)m_day, (uint32_t)e);
+        //이벤트 확률 체크
+        if (rng.random_num(1, 100) > event.chance) continue;
+
+        //이벤트 타겟 결정 (특징 비트셋/역색인으로 후보 수집)
+        collectCandidates((int)e);
+        vector<int>& candidates = m_candidates;
+
+        //후보가 존재하는지 확인
+        if (candidates.empty()) continue;
+        //쿨타임 시작
+        m_cooldown[e] = event.cooltime;
+        m_firedEvents.push_back((int)e);
+        PROFILE_COUNT(m_profiler, EventsFired, 1);
+
+        //단일 대상 이벤트면 후보 하나만 랜덤 선택, 전체 대상 이벤트면 후보 전체
+        if (event.single) {
+            int idx = rng.random_num(0, candidates.size() - 1);
+            candidates[0] = candidates[idx];
+            candidates.resize(1);
+        }
+        //주가 변동 시작
+        PROFILE_SCOPE(m_profiler, EffectApply);
+        for (int c : candidates) {
+            //기준가 변경
+            m_basePrice[c] *= (1.0 + event.impact / 100.0);
+            //영향(이펙트) 적용
+            for (int eff : scenario.eventEffects((int)e)) AddEffect(c, eff);
+        }
+        //뉴스: 이벤트는 하루에 한 번만 발생하고 후보 회사는 서로 다르므로 (이벤트, 회사)는 겹치지 않음
+        //회사 이름이 들어가지 않는 문장은 회사와 무관하게 한 번만
+        if (event.hasCompany) {
+            for (int c : candidates) finalNews.push_back({(int)e, c});
+        } else {
+            finalNews.push_back({(int)e, -1});
+        }
+    }
+    //일반 뉴스 추가 (중복 검사는 일반 뉴스끼리만, 많아야 3개)
+    PROFILE_SCOPE(m_profiler, NewsBuild);
+    RandomStream newsRng(m_seed, RandomStream::News, (uint32_t)m_day, 0);
+    if (scenario.newsCount() > 0) {
+        const size_t eventNews = finalNews.size();
+        int newsCount = newsRng.random_num(2, 3);
+        for (int i = 0; i < newsCount; i++) {
+            NewsItem candidate{-1, newsRng.random_num(0, scenario.newsCount() - 1)};
+            if (find(finalNews.begin() + eventNews, finalNews.end(), candidate) == finalNews.end()) finalNews.push_back(candidate);
+        }
+    }
+    //뉴스 순서 섞기
+    newsRng.shuffle(finalNews.data(), (int)finalNews.size());
+}
+
+//이벤트 하나의 후보 회사를 m_candidates에 오름차순으로 모읍니다.
+//타겟 특징을 가진 회사가 적으면 역색인 목록을 합치고, 많으면 비트셋 AND로 전체를 훑습니다.
+void Market::collectCandidates(int eventIndex) {
+    PROFILE_SCOPE(m_profiler, EventScan);
+    const Scenario& scenario = *m_scenario;
+    const sgsc::EventRecord& event = scenario.event(eventIndex);
+    const IdSpan targets = scenario.eventTargets(eventIndex);
+    const int companies = companyCount();
+    const int featureWords = scenario.featureWords();
+    m_candidates.clear();
+
+    if (targets.empty()) {
+        for (int c = 0; c < companies; c++) m_candidates.push_back(c);
+    } else {
+        size_t postings = 0;
+        for (int f : targets) postings += scenario.featurePostings(f).size();
+
+        if (postings * 4 < (size_t)companies) {
+            for (int f : targets) {
+                IdSpan list = scenario.featurePostings(f);
+                m_candidates.insert(m_candidates.end(), list.begin(), list.end());
+            }
+            if (targets.size() > 1) {
+                sort(m_candidates.begin(), m_candidates.end());
+                m_candidates.erase(unique(m_candidates.begin(), m_candidates.end()), m_candidates.end());
+            }
+        } else {
+            const uint64_t* target = scenario.eventTargetBits(eventIndex);
+            for (int c = 0; c < companies; c++) {
+                if (bits::intersects(scenario.companyFeatureBits(c), target, featureWords))
+                    m_candidates.push_back(c);
+            }
+        }
+    }
+
+    //중복 적용 검사: 중첩 불가 이벤트는 이미 같은 이펙트가 걸린 회사를 제외
+    if (event.stackable && event.effectCount > 0) {
+        const uint64_t* effects = scenario.eventEffectBits(eventIndex);
+        size_t kept = 0;
+        for (int c : m_candidates) {
+            if (!bits::intersects(&m_activeEffectBits[(size_t)c * m_effectWords], effects, m_effectWords))
+                m_candidates[kept++] = c;
+        }
+        m_candidates.resize(kept);
+    }
+}
+
+void Market::appendNewsText(const NewsItem& item, string& out) const {
+    if (item.event < 0) { out += m_scenario->news(item.index); return; }
+    const NewsTemplate& t = m_scenario->newsTemplate(item.event);
+    out += m_scenario->text(t.head);
+    if (!t.hasSlot) return;
+    if (item.index >= 0) out += companyName(item.index);
+    else out += "<company>";
+    out += m_scenario->text(t.tail);
+}
+
+string Market::newsText(const NewsItem& item) const {
+    string msg;
+    appendNewsText(item, msg);
+    return msg;
+}
+
+vector<string> Market::todayNews() const {
+    vector<string> list;
+    list.reserve(m_todayNews.size());
+    for (const auto& item : m_todayNews) list.push_back(newsText(item));
+    return list;
+}
+
+void Market::calculateTotalAsset() {
+    PROFILE_SCOPE(m_profiler, TotalAsset);
+    double stockVal = 0;
+    for(size_t c = 0; c < m_amount.size(); c++) stockVal += (m_finalPrice[c] * m_amount[c]);
+    //미체결 주문에 묶어 둔 현금과 주식
+    for(const PendingOrder& o : m_orders)
+        stockVal += o.buy ? (double)o.price * o.remaining : m_finalPrice[o.company] * o.remaining;
+    m_totalAsset = m_cash + stockVal;
+}
+
+//회사별 상태 배열을 시작 상태로 초기화
+void Market::resetState() {
+    const Scenario& scenario = *m_scenario;
+    const size_t companies = scenario.companyCount();
+    m_basePrice.resize(companies);
+    m_finalPrice.resize(companies);
+    m_impactSum.assign(companies, 0);
+    m_amount.assign(companies, 0);
+    m_effects.assign(companies, {});
+    m_history.assign(companies, PriceHistory());
+    m_bars.assign(companies * m_intraday.barsPerDay(), Bar{});
+    m_candles.assign(companies, {});
+    for (size_t c = 0; c < companies; c++) {
+        const double initialPrice = scenario.company((int)c).initialPrice;
+        m_basePrice[c] = m_finalPrice[c] = initialPrice;
+        //history에 초기값(BasePrice)을 미리 넣어두어 D0 값을 확보합니다.
+        m_history[c].push(initialPrice);
+    }
+    m_indicators.rebuild(m_history);
+
+    m_cooldown.resize(scenario.eventCount());
+    for (int e = 0; e < scenario.eventCount(); e++) m_cooldown[e] = scenario.event(e).startCooltime;
+
+    m_effectWords = scenario.effectWords();
+    m_activeEffectBits.assign(companies * m_effectWords, 0);
+
+    m_books.clear();
+    m_bookCompany.clear();
+    m_freeBooks.clear();
+    m_bookOf.assign(companies, -1);
+    m_orders.clear();
+    m_nextOrderId = 1;
+}
+
+// ---- 저장/이어하기 ----
+
+namespace {
+
+constexpr uint32_t SnapshotMagic = 0x56534753; //"SGSV"
+constexpr uint32_t SnapshotVersion = 4;
+
+//헤더 뒤에 필드별 배열이 이어집니다.
+//basePrice, finalPrice (double × 회사) → impactSum, amount (int32 × 회사) → 쿨타임 (int32 × 이벤트)
+//→ 회사별 이펙트 수 (uint32 × 회사) + SavedEffect들
+//→ 회사별 기록의 봉 구간 (SavedRollup × 회사) + 봉들 → 원본 구간 길이 (uint32 × 회사) + 값들
+//→ 오늘의 뉴스 (int32 쌍) → 발생한 이벤트 (int32) → 미체결 주문 (SavedOrder)
+//→ 주문장마다 (회사 int32, 주문 수 uint32) + SavedBookOrder들 (매수 → 매도, 체결 우선순위 순)
+//→ 장중 모드일 때만: 오늘의 장중 봉 (Bar × 회사 × barsPerDay) → 회사별 일봉 수 (uint32 × 회사) + 일봉들
+struct SnapshotHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t seed;
+    uint64_t scenario; //Scenario::fingerprint()
+    uint64_t journalRecords;
+    int32_t day;
+    uint32_t companies;
+    uint32_t events;
+    uint32_t newsItems;
+    uint32_t firedEvents;
+    uint32_t pendingOrders;
+    uint32_t books;
+    uint32_t nextOrderId;
+    double cash;
+    double totalAsset;
+    double prevAsset;
+    int32_t intradayTicks;
+    int32_t ticksPerBar;
+    double intradayVolatility;
+    double intradayVolume;
+};
+
+struct SavedEffect {
+    int32_t id;
+    int32_t impact;
+    int32_t duration;
+    uint32_t reversed;
+};
+
+struct SavedRollup {
+    uint64_t days; //봉으로 묶인 날 수
+    uint32_t span; //봉 하나의 날 수
+    uint32_t bars;
+};
+
+struct SavedOrder {
+    uint32_t id;
+    int32_t company;
+    int32_t buy;
+    int32_t quantity;
+    int32_t remaining;
+    uint32_t reserved;
+    int64_t price;
+};
+
+struct SavedBookOrder {
+    int64_t price;
+    int64_t quantity;
+    uint32_t owner;
+    uint32_t side;
+};
+
+static_assert(sizeof(SnapshotHeader) == 112 && sizeof(Bar) == 40 && sizeof(SavedOrder) == 32 && sizeof(SavedBookOrder) == 24 &&
+              sizeof(SavedRollup) == 16 && sizeof(PriceHistory::Bucket) == 32,
+              "snapshot layout changed");
+
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(vector<char>& out) : m_out(out) { m_out.clear(); }
+    template<class T> void put(const T& v) { put(&v, 1); }
+    template<class T> void put(const T* items, size_t count) {
+        const char* p = reinterpret_cast<const char*>(items);
+        m_out.insert(m_out.end(), p, p + count * sizeof(T));
+    }
+
+private:
+    vector<char>& m_out;
+};
+
+//범위를 벗어나면 실패 상태가 되고 이후 읽기는 모두 무시됩니다.
+class SnapshotReader {
+public:
+    SnapshotReader(const char* data, size_t size) : m_data(data), m_size(size) {}
+    template<class T> bool get(T& v) { return get(&v, 1); }
+    template<class T> bool get(T* items, size_t count) {
+        if (!m_ok || count > (m_size - m_pos) / sizeof(T)) return m_ok = false;
+        memcpy(items, m_data + m_pos, count * sizeof(T));
+        m_pos += count * sizeof(T);
+        return true;
+    }
+    bool ok() const { return m_ok; }
+    bool atEnd() const { return m_pos == m_size; }
+    size_t remaining() const { return m_size - m_pos; }
+
+private:
+    const char* m_data;
+    size_t m_size;
+    size_t m_pos = 0;
+    bool m_ok = true;
+};
+
+}
+
+void Market::saveSnapshot(vector<char>& out, uint64_t journalRecords) const {
+    const size_t companies = m_history.size();
+    SnapshotHeader h{};
+    h.magic = SnapshotMagic;
+    h.version = SnapshotVersion;
+    h.seed = m_seed;
+    h.scenario = m_scenario->fingerprint();
+    h.journalRecords = journalRecords;
+    h.day = m_day;
+    h.companies = (uint32_t)companies;
+    h.events = (uint32_t)m_cooldown.size();
+    h.newsItems = (uint32_t)m_todayNews.size();
+    h.firedEvents = (uint32_t)m_firedEvents.size();
+    h.pendingOrders = (uint32_t)m_orders.size();
+    h.books = (uint32_t)(m_books.size() - m_freeBooks.size());
+    h.nextOrderId = m_nextOrderId;
+    h.cash = m_cash;
+    h.totalAsset = m_totalAsset;
+    h.prevAsset = m_prevAsset;
+    h.intradayTicks = m_intraday.ticks;
+    h.ticksPerBar = m_intraday.ticksPerBar;
+    h.intradayVolatility = m_intraday.volatility;
+    h.intradayVolume = m_intraday.volume;
+
+    SnapshotWriter w(out);
+    w.put(h);
+    w.put(m_basePrice.data(), companies);
+    w.put(m_finalPrice.data(), companies);
+    w.put(m_impactSum.data(), companies);
+    w.put(m_amount.data(), companies);
+    w.put(m_cooldown.data(), m_cooldown.size());
+    for (const auto& effects : m_effects) w.put((uint32_t)effects.size());
+    for (const auto& effects : m_effects) {
+        for (const auto& e : effects) w.put(SavedEffect{ e.id, e.impact, e.duration, e.reversed ? 1u : 0u });
+    }
+    for (const auto& history : m_history) {
+        const MinMaxDownsampler& rollup = history.rollup();
+        w.put(SavedRollup{ (uint64_t)rollup.count(), (uint32_t)rollup.span(), (uint32_t)rollup.buckets().size() });
+    }
+    for (const auto& history : m_history) w.put(history.rollup().buckets().data(), history.rollup().buckets().size());
+    for (const auto& history : m_history) w.put((uint32_t)(history.size() - history.exactBegin()));
+    vector<double> exact;
+    for (const auto& history : m_history) {
+        exact.clear();
+        history.copy(history.exactBegin(), history.size(), exact);
+        w.put(exact.data(), exact.size());
+    }
+    for (const auto& item : m_todayNews) { w.put((int32_t)item.event); w.put((int32_t)item.index); }
+    w.put(m_firedEvents.data(), m_firedEvents.size());
+    for (const auto& o : m_orders)
+        w.put(SavedOrder{ o.id, o.company, o.buy ? 1 : 0, o.quantity, o.remaining, 0, o.price });
+    for (size_t b = 0; b < m_books.size(); b++) {
+        if (m_bookCompany[b] < 0) continue;
+        const OrderBook& book = m_books[b];
+        w.put((int32_t)m_bookCompany[b]);
+        w.put((uint32_t)book.orderCount());
+        for (OrderBook::Side side : { OrderBook::Buy, OrderBook::Sell }) {
+            book.forEachOrder(side, [&](OrderBook::OrderId, int64_t price, int64_t quantity, uint32_t owner) {
+                w.put(SavedBookOrder{ price, quantity, owner, (uint32_t)side });
+            });
+        }
+    }
+    if (m_intraday.barsPerDay() > 0) {
+        w.put(m_bars.data(), m_bars.size());
+        for (const auto& candles : m_candles) w.put((uint32_t)candles.size());
+        for (const auto& candles : m_candles) w.put(candles.data(), candles.size());
+    }
+}
+
+bool Market::loadSnapshot(const char* data, size_t size, string* error, uint64_t* journalRecords) {
+    auto fail = [&](const char* why) { if (error) *error = why; return false; };
+    const Scenario& scenario = *m_scenario;
+    SnapshotReader r(data, size);
+    SnapshotHeader h;
+    if (!r.get(h) || h.magic != SnapshotMagic) return fail("not a save file");
+    if (h.version != SnapshotVersion) return fail("unsupported save version");
+    if (h.scenario != scenario.fingerprint()) return fail("save was made with a different scenario");
+    if (h.companies != (uint32_t)scenario.companyCount() || h.events != (uint32_t)scenario.eventCount())
+        return fail("save does not match the scenario");
+
+    //검사가 모두 끝날 때까지 현재 상태는 건드리지 않음
+    Market m(*this);
+    const size_t companies = h.companies;
+    m.m_seed = h.seed;
+    m.m_day = h.day;
+    m.m_cash = h.cash;
+    m.m_totalAsset = h.totalAsset;
+    m.m_prevAsset = h.prevAsset;
+    r.get(m.m_basePrice.data(), companies);
+    r.get(m.m_finalPrice.data(), companies);
+    r.get(m.m_impactSum.data(), companies);
+    r.get(m.m_amount.data(), companies);
+    r.get(m.m_cooldown.data(), h.events);
+
+    vector<uint32_t> counts(companies);
+    r.get(counts.data(), companies);
+    m.m_activeEffectBits.assign(companies * m.m_effectWords, 0);
+    for (size_t c = 0; c < companies && r.ok(); c++) {
+        vector<ActiveEffect>& effects = m.m_effects[c];
+        effects.clear();
+        int64_t sum = 0;
+        for (uint32_t i = 0; i < counts[c]; i++) {
+            SavedEffect e;
+            if (!r.get(e)) break;
+            if (e.id < 0 || e.id >= scenario.effectCount()) return fail("save has an unknown effect");
+            //같은 이펙트는 회사당 하나, impact는 원래 값이거나 반전된 값뿐
+            const int impact = scenario.effect(e.id).impact;
+            if (bits::test(&m.m_activeEffectBits[c * m.m_effectWords], e.id) || e.impact != (e.reversed ? -impact : impact))
+                return fail("save has an invalid effect");
+            effects.push_back({ e.id, e.impact, e.duration, e.reversed != 0 });
+            bits::set(&m.m_activeEffectBits[c * m.m_effectWords], e.id);
+            sum += e.impact;
+        }
+        //합계는 이펙트에서 다시 계산한 값과 같아야 함 (다르면 이후 가격이 어긋남)
+        if (r.ok() && sum != m.m_impactSum[c]) return fail("save has an inconsistent effect total");
+    }
+
+    vector<SavedRollup> rollups(companies);
+    r.get(rollups.data(), companies);
+    vector<vector<PriceHistory::Bucket>> bars(companies);
+    for (size_t c = 0; c < companies && r.ok(); c++) {
+        if (rollups[c].bars > r.remaining() / sizeof(PriceHistory::Bucket)) return fail("save file is truncated or corrupt");
+        bars[c].resize(rollups[c].bars);
+        r.get(bars[c].data(), rollups[c].bars);
+    }
+    r.get(counts.data(), companies);
+    vector<double> exact;
+    for (size_t c = 0; c < companies && r.ok(); c++) {
+        if (counts[c] > r.remaining() / sizeof(double)) return fail("save file is truncated or corrupt");
+        exact.resize(counts[c]);
+        r.get(exact.data(), counts[c]);
+        //오늘 가격은 항상 원본 구간에 있어야 함
+        if (counts[c] == 0 || !m.m_history[c].restore(bars[c].data(), bars[c].size(), rollups[c].span, rollups[c].days,
+                                                     exact.data(), exact.size()))
+            return fail("save has an invalid price history");
+    }
+
+    m.m_todayNews.clear();
+    for (uint32_t i = 0; i < h.newsItems && r.ok(); i++) {
+        int32_t event, index;
+        r.get(event);
+        r.get(index);
+        bool valid = (event < 0) ? (index >= 0 && index < scenario.newsCount())
+                                 : (event < scenario.eventCount() && index >= -1 && index < (int)companies);
+        if (!valid) return fail("save has an unknown news item");
+        m.m_todayNews.push_back({ event, index });
+    }
+    if (h.firedEvents > r.remaining() / sizeof(int32_t)) return fail("save file is truncated or corrupt");
+    m.m_firedEvents.resize(h.firedEvents);
+    r.get(m.m_firedEvents.data(), h.firedEvents);
+    for (int e : m.m_firedEvents) {
+        if (e < 0 || e >= scenario.eventCount()) return fail("save has an unknown event");
+    }
+
+    //미체결 주문 → 주문장 (주문장 안의 플레이어 주문은 미체결 목록과 하나씩 맞아야 함)
+    m.m_books.clear();
+    m.m_bookCompany.clear();
+    m.m_freeBooks.clear();
+    m.m_bookOf.assign(companies, -1);
+    m.m_orders.clear();
+    m.m_nextOrderId = h.nextOrderId;
+    if (h.pendingOrders > r.remaining() / sizeof(SavedOrder)) return fail("save file is truncated or corrupt");
+    for (uint32_t i = 0; i < h.pendingOrders && r.ok(); i++) {
+        SavedOrder o;
+        r.get(o);
+        bool valid = o.id > 0 && o.id < h.nextOrderId && (m.m_orders.empty() || m.m_orders.back().id < o.id) &&
+                     o.company >= 0 && o.company < (int)companies && o.price > 0 &&
+                     o.remaining > 0 && o.remaining <= o.quantity;
+        if (!valid) return fail("save has an invalid order");
+        m.m_orders.push_back({ o.id, o.company, o.buy != 0, o.price, o.quantity, o.remaining, OrderBook::NoOrder });
+    }
+    size_t linked = 0;
+    for (uint32_t b = 0; b < h.books && r.ok(); b++) {
+        int32_t company;
+        uint32_t count;
+        r.get(company);
+        r.get(count);
+        if (!r.ok()) break;
+        if (company < 0 || company >= (int)companies || m.m_bookOf[company] >= 0) return fail("save has an invalid order book");
+        if (count > r.remaining() / sizeof(SavedBookOrder)) return fail("save file is truncated or corrupt");
+        m.m_bookOf[company] = (int)m.m_books.size();
+        m.m_bookCompany.push_back(company);
+        m.m_books.emplace_back();
+        OrderBook& book = m.m_books.back();
+        for (uint32_t i = 0; i < count; i++) {
+            SavedBookOrder o;
+            r.get(o);
+            if (o.price <= 0 || o.quantity <= 0 || o.side > OrderBook::Sell) return fail("save has an invalid order book");
+            OrderBook::Side side = (OrderBook::Side)o.side;
+            OrderBook::OrderId id = book.rest(side, o.price, o.quantity, o.owner);
+            if (o.owner == MakerOwner) continue;
+            PendingOrder* order = m.findOrder(o.owner);
+            if (!order || order->company != company || order->buy != (side == OrderBook::Buy) ||
+                order->price != o.price || order->remaining != o.quantity || order->bookOrder != OrderBook::NoOrder)
+                return fail("save has an invalid order book");
+            order->bookOrder = id;
+            linked++;
+        }
+    }
+    if (linked != m.m_orders.size()) return fail("save has an invalid order book");
+
+    IntradayConfig intraday;
+    intraday.ticks = h.intradayTicks;
+    intraday.ticksPerBar = h.ticksPerBar;
+    intraday.volatility = h.intradayVolatility;
+    intraday.volume = h.intradayVolume;
+    m.setIntraday(intraday);
+    if (!(m.m_intraday == intraday)) return fail("save has an invalid intraday setting");
+    if (intraday.barsPerDay() > 0) {
+        r.get(m.m_bars.data(), m.m_bars.size());
+        r.get(counts.data(), companies);
+        for (size_t c = 0; c < companies && r.ok(); c++) {
+            if (counts[c] > r.remaining() / sizeof(Bar)) return fail("save file is truncated or corrupt");
+            m.m_candles[c].resize(counts[c]);
+            r.get(m.m_candles[c].data(), counts[c]);
+        }
+    }
+    if (!r.ok() || !r.atEnd()) return fail("save file is truncated or corrupt");
+    m.m_indicators.rebuild(m.m_history);
+
+    *this = move(m);
+    if (journalRecords) *journalRecords = h.journalRecords;
+    return true;
+}
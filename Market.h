@@ -0,0 +1,226 @@
+﻿#ifndef MARKET_H
+#define MARKET_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <random>
+#include <cstdint>
+#include "Indicators.h"
+#include "Intraday.h"
+#include "PriceHistory.h"
+#include "OrderBook.h"
+#include "Random.h"
+#include "Scenario.h"
+
+using namespace std;
+
+class Profiler;
+class ThreadPool;
+
+//회사에 적용중인 영향 (이름 대신 시나리오의 이펙트 인덱스를 가짐)
+struct ActiveEffect {
+    int id; //이펙트 인덱스
+    int impact; //주가에 미치는 영향
+    int duration; //남은 지속시간
+    bool reversed; //종료 후 반전 플래그
+};
+
+//오늘의 뉴스 한 줄 (턴 진행 중에는 문자열 대신 ID만 기록)
+struct NewsItem {
+    int event; //이벤트 인덱스 (-1이면 일반 뉴스)
+    int index; //이벤트 뉴스: 회사 인덱스(회사 무관이면 -1), 일반 뉴스: 시나리오 뉴스 인덱스
+    bool operator==(const NewsItem& o) const { return event == o.event && index == o.index; }
+};
+
+//주문장에 남아 있는 플레이어 지정가 주문
+struct PendingOrder {
+    uint32_t id; //게임 안의 주문 번호 (1부터, 저널/UI에서 사용)
+    int company;
+    bool buy;
+    int64_t price; //지정가 (원)
+    int quantity; //처음 주문 수량
+    int remaining; //미체결 수량
+    OrderBook::OrderId bookOrder; //주문장 안의 노드 (다음 날 호가를 다시 세우면 바뀜)
+};
+
+// Qt에 의존하지 않는 시장 시뮬레이션 코어
+// GameBackend(UI)와 밸런스 러너(CLI)가 같은 로직을 공유합니다.
+// 회사/이벤트/뉴스 등 정적 데이터는 읽기 전용 Scenario를 공유하고, Market에는 게임마다 바뀌는 상태만 있습니다.
+// 그래서 Market 복사(몬테카를로/더블 버퍼)는 상태 배열만 복사합니다.
+class Market {
+public:
+    //같은 시드 + 같은 거래 입력이면 스레드 수와 무관하게 항상 같은 게임이 됩니다.
+    explicit Market(uint64_t seed = randomSeed());
+    explicit Market(shared_ptr<const Scenario> scenario, uint64_t seed = randomSeed());
+    static uint64_t randomSeed() { random_device rd; return (uint64_t(rd()) << 32) | rd(); }
+
+    void reseed(uint64_t seed) { m_seed = seed; }
+    uint64_t seed() const { return m_seed; }
+
+    //회사가 많을 때 주가 계산을 나눠 돌릴 스레드 풀 (nullptr이면 단일 스레드)
+    void setThreadPool(ThreadPool* pool) { m_pool = pool; }
+    //단계별 시간/카운터를 모을 프로파일러 (nullptr이면 끔, STOCKGAME_PROFILE 빌드에서만 기록)
+    //복사본(더블 버퍼, 몬테카를로)도 같은 프로파일러를 가리킵니다.
+    void setProfiler(Profiler* profiler) { m_profiler = profiler; }
+    Profiler* profiler() const { return m_profiler; }
+
+    //장중 틱 모드 (기본은 끔). 켜면 주가 계산 때 하루를 config.ticks개 틱으로 나눠 장중 봉과 일봉을 만듭니다.
+    //종가는 끈 것과 같으므로 게임 진행 중 언제 켜고 꺼도 결과는 그대로이고, 일봉은 켠 날부터 쌓입니다.
+    void setIntraday(const IntradayConfig& config);
+    const IntradayConfig& intraday() const { return m_intraday; }
+
+    //보조 지표 (기본은 끔). 켜면 종가가 붙을 때마다 회사별 누적값을 O(1)로 갱신합니다.
+    //설정을 바꾸면 지금까지의 기록으로 다시 쌓으므로 게임 도중에 켜도 처음부터 켠 것과 같습니다.
+    void setIndicators(const IndicatorConfig& config);
+    const IndicatorConfig& indicators() const { return m_indicators.config(); }
+
+    //하루 진행 (이벤트 쿨타임 → 이펙트 갱신 → 이벤트 발생 → 주가 계산 → 주문장 갱신)
+    void nextTurn();
+
+    //거래는 회사별 주문장을 거칩니다. 시장 조성 호가는 현재가 주변에 한정된 물량만 있어서
+    //큰 주문은 여러 호가를 훑으며 가격이 밀리고, 마지막 체결가가 현재가/기준가에 반영됩니다.
+    //시장가 매수: 현금이 닿는 만큼 amount까지 체결 (하나도 체결되지 않으면 false)
+    bool buyStock(int index, int amount);
+    //시장가 매도: 보유량이 amount 이상이어야 하며, 매수 호가가 모자라면 일부만 체결
+    bool sellStock(int index, int amount);
+    //지정가 주문: 바로 체결되는 만큼 체결하고 나머지는 주문장에 남깁니다.
+    //남은 동안 매수는 지정가 × 수량만큼 현금을, 매도는 주식을 묶어 둡니다. 반환: 주문 번호 (거부되면 0)
+    uint32_t placeLimitOrder(int index, bool buy, double price, int amount);
+    bool cancelOrder(uint32_t id);
+    void calculateTotalAsset();
+
+    //저장/이어하기: 게임 상태(날짜, 자금, 회사별 주가/이펙트/보유량/기록, 이벤트 쿨타임, 오늘의 뉴스, 주문장)만 저장합니다.
+    //시나리오 데이터는 지문만 기록해서 다른 시나리오의 세이브를 불러오는 것을 막습니다.
+    //journalRecords: 이 상태까지 반영된 저널 기록 수 (이어하기 시 그 뒤부터 다시 적용)
+    void saveSnapshot(vector<char>& out, uint64_t journalRecords = 0) const;
+    bool loadSnapshot(const char* data, size_t size, string* error = nullptr, uint64_t* journalRecords = nullptr);
+
+    //nextTurn의 단계들 (벤치마크/프로파일에서 단계별로 따로 호출할 수 있도록 공개)
+    void TickCooldowns();
+    void UpdateEffects();
+    void ProcessEvents();
+    void CalculatePrices();
+
+    int day() const { return m_day; }
+    double cash() const { return m_cash; }
+    double totalAsset() const { return m_totalAsset; }
+    double prevAsset() const { return m_prevAsset; }
+    double goalAmount() const { return m_scenario->goal(); }
+    int maxDay() const { return m_scenario->lastDay(); }
+    bool isOver() const { return m_day > maxDay(); }
+    bool isVictory() const { return m_totalAsset >= goalAmount(); }
+
+    const Scenario& scenario() const { return *m_scenario; }
+    const shared_ptr<const Scenario>& sharedScenario() const { return m_scenario; }
+    int companyCount() const { return m_scenario->companyCount(); }
+    string_view companyName(int index) const { return m_scenario->text(m_scenario->company(index).name); }
+    string_view companyDescription(int index) const { return m_scenario->text(m_scenario->company(index).description); }
+    double price(int index) const { return m_finalPrice[index]; }
+    double basePrice(int index) const { return m_basePrice[index]; }
+    int owned(int index) const { return m_amount[index]; }
+    int impactSum(int index) const { return m_impactSum[index]; }
+    const vector<ActiveEffect>& activeEffects(int index) const { return m_effects[index]; }
+    //종가 기록 (최근은 원본, 오래된 날은 압축/봉으로 묶여서 회사당 메모리가 거의 일정)
+    const PriceHistory& history(int index) const { return m_history[index]; }
+    //장중 모드: 일봉 (장중 모드를 켠 날부터), 오늘의 장중 봉 (intradayBarCount()개)
+    const vector<Bar>& candles(int index) const { return m_candles[index]; }
+    const Bar* intradayBars(int index) const { return m_bars.data() + (size_t)index * m_intraday.barsPerDay(); }
+    int intradayBarCount() const { return m_intraday.barsPerDay(); }
+    //보조 지표: 현재 값, 차트 오버레이용 날짜별 이동평균 (history와 길이가 같음, 꺼져 있으면 비어 있음)
+    const IndicatorValues& indicatorValues(int index) const { return m_indicators.values(index); }
+    const PriceHistory& smaSeries(int index) const { return m_indicators.smaSeries(index); }
+    const PriceHistory& emaSeries(int index) const { return m_indicators.emaSeries(index); }
+    int eventCount() const { return m_scenario->eventCount(); }
+    string_view eventName(int event) const { return m_scenario->text(m_scenario->event(event).name); }
+    int cooldown(int event) const { return m_cooldown[event]; }
+    double changeRate(int index) const;
+
+    //미체결 지정가 주문 (주문 번호 오름차순)
+    const vector<PendingOrder>& pendingOrders() const { return m_orders; }
+    //회사 주문장 (오늘 거래나 미체결 주문이 없으면 nullptr)
+    const OrderBook* orderBook(int index) const {
+        return m_bookOf[index] < 0 ? nullptr : &m_books[m_bookOf[index]];
+    }
+
+    //시장 조성 호가 (쪽마다 BookLevels개, [0]이 최우선 호가, 가격이 0 이하인 매수 레벨은 quantity 0)
+    //(시드, 날짜, 회사, 현재가)만으로 정해지므로 주문장 없이도 같은 호가를 계산할 수 있습니다. (백테스트용)
+    static constexpr int BookLevels = 10;
+    struct MakerLevel { int64_t price; int64_t quantity; };
+    static void makerLevels(uint64_t seed, int day, int company, double price, MakerLevel* asks, MakerLevel* bids);
+
+    //오늘 발행된 뉴스(섞인 순서)와 발생한 이벤트 인덱스
+    const vector<NewsItem>& todayNewsItems() const { return m_todayNews; }
+    vector<string> todayNews() const;
+    string newsText(const NewsItem& item) const;
+    //뉴스 한 줄을 out 뒤에 이어 붙임 (미리 나눈 문장 조각 + 회사 이름, 버퍼를 재사용하면 할당 없음)
+    void appendNewsText(const NewsItem& item, string& out) const;
+    const vector<int>& firedEvents() const { return m_firedEvents; }
+
+private:
+    int m_day = 1;
+    double m_cash = 1200000;
+    double m_totalAsset = 1200000;
+    double m_prevAsset = 1200000;
+
+    shared_ptr<const Scenario> m_scenario; //정적 데이터 (모든 복사본이 공유)
+    vector<int> m_cooldown; //이벤트별 남은 쿨타임(일수)
+
+    //회사별 상태 (구조체 배열 대신 필드별 연속 배열, 인덱스 = 회사 번호)
+    vector<double> m_basePrice; //기본 주가
+    vector<double> m_finalPrice; //계산 후의 최종 주가
+    vector<int> m_impactSum; //적용중인 이펙트 impact 합계 (이펙트 변경 시 갱신)
+    vector<int> m_amount; //보유중인 주식 수
+    vector<vector<ActiveEffect>> m_effects; //적용중인 영향(이펙트)
+    vector<PriceHistory> m_history; //주가 변동 기록
+
+    //주가 커널에 넘길 하루치 난수 배열 (재사용 버퍼)
+    vector<double> m_minorDraw, m_buffDraw, m_noiseDraw;
+
+    //장중 모드: 오늘의 장중 봉은 회사 × barsPerDay 고정 크기 배열을 매일 덮어쓰고, 틱은 저장하지 않음
+    IntradayConfig m_intraday;
+    vector<Bar> m_bars;
+    vector<vector<Bar>> m_candles; //회사별 일봉
+
+    //보조 지표는 history에서 언제든 다시 만들 수 있어서 저장하지 않음
+    IndicatorEngine m_indicators;
+
+    //이벤트 타겟 판정용 비트셋/역색인은 시나리오에 미리 계산되어 있고, 여기에는 게임 상태만 둡니다.
+    int m_effectWords = 1;
+    vector<uint64_t> m_activeEffectBits; //회사별 적용중 이펙트 비트셋 (턴마다 갱신)
+    vector<int> m_candidates; //후보 목록 재사용 버퍼
+
+    vector<NewsItem> m_todayNews;
+    vector<int> m_firedEvents;
+
+    //주문장은 거래가 있는 회사에만 만들고 하루가 지나면 돌려받아 재사용합니다.
+    vector<OrderBook> m_books;
+    vector<int> m_bookCompany; //주문장 → 회사 (-1이면 비어 있음)
+    vector<int> m_bookOf; //회사 → 주문장 (-1이면 없음)
+    vector<int> m_freeBooks;
+    vector<PendingOrder> m_orders;
+    uint32_t m_nextOrderId = 1;
+    static constexpr uint32_t MakerOwner = 0; //시장 조성 호가 (플레이어 주문은 주문 번호가 owner)
+    static constexpr double BookStep = 0.002; //호가 간격 (현재가 대비)
+    static constexpr double LevelDepth = 1500000; //최우선 호가 한 레벨의 물량 (금액, 먼 레벨일수록 늘어남)
+
+    uint64_t m_seed;
+    ThreadPool* m_pool = nullptr;
+    Profiler* m_profiler = nullptr;
+    static constexpr size_t ParallelThreshold = 8192; //이보다 회사가 적으면 병렬화하지 않음
+    static constexpr size_t ParallelGrain = 4096; //병렬 작업 하나가 맡는 회사 수
+
+    OrderBook& bookFor(int company);
+    void seedLiquidity(OrderBook& book, int company);
+    void rollBooks();
+    void applyTradePrice(int company, int64_t price, int64_t quantity);
+    PendingOrder* findOrder(uint32_t id);
+    void settleMakerFill(const OrderBook::Fill& fill);
+    void collectCandidates(int eventIndex);
+    void resetState();
+    ActiveEffect* CheckEffect(int company, int effectId);
+    void AddEffect(int company, int effectId);
+};
+
+#endif // MARKET_H
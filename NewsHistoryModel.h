@@ -0,0 +1,106 @@
+﻿#ifndef NEWSHISTORYMODEL_H
+#define NEWSHISTORYMODEL_H
+
+#include <QAbstractListModel>
+#include <QString>
+#include <QVector>
+#include "Market.h"
+
+// 날짜별 뉴스 기록 모델 (QML 뉴스 아카이브에 직접 연결)
+// 문자열 대신 뉴스 ID(NewsItem)만 한 배열에 이어 붙여 두고, 날짜마다 그 구간만 기억합니다.
+// 본문은 화면이 요청할 때 재사용 버퍼에 한 번에 만들어서 QString으로 한 번만 바꿉니다.
+// 행 0은 게임 시작 전 안내(사전 브리핑)입니다.
+class NewsHistoryModel : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    enum Roles {
+        DayRole = Qt::UserRole + 1,
+        TitleRole,
+        BodyRole,
+    };
+
+    explicit NewsHistoryModel(const Market* market, QObject *parent = nullptr)
+        : QAbstractListModel(parent), m_market(market) { clear(); }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override {
+        return parent.isValid() ? 0 : (int)m_rows.size();
+    }
+    int count() const { return (int)m_rows.size(); }
+
+    QVariant data(const QModelIndex &index, int role) const override {
+        if (!index.isValid() || index.row() >= (int)m_rows.size()) return QVariant();
+        switch (role) {
+        case DayRole: return m_rows[index.row()].day;
+        case TitleRole: return title(index.row());
+        case BodyRole: return body(index.row());
+        }
+        return QVariant();
+    }
+
+    QHash<int, QByteArray> roleNames() const override {
+        return {
+            { DayRole, "dayIdx" },
+            { TitleRole, "title" },
+            { BodyRole, "body" },
+        };
+    }
+
+    void clear() {
+        beginResetModel();
+        m_rows.clear();
+        m_items.clear();
+        m_rows.append({ 0, 0, 0 });
+        endResetModel();
+        emit countChanged();
+    }
+
+    //하루치 뉴스 추가 (ID만 복사)
+    void append(int day, const vector<NewsItem>& items) {
+        const int row = (int)m_rows.size();
+        beginInsertRows(QModelIndex(), row, row);
+        const uint32_t begin = (uint32_t)m_items.size();
+        m_items.insert(m_items.end(), items.begin(), items.end());
+        m_rows.append({ day, begin, (uint32_t)m_items.size() });
+        endInsertRows();
+        emit countChanged();
+    }
+
+    Q_INVOKABLE QString title(int row) const {
+        if (row < 0 || row >= (int)m_rows.size()) return QString();
+        if (row == 0) return QStringLiteral("사전 브리핑");
+        return QString::asprintf("Day %d 일일 브리핑", m_rows[row].day);
+    }
+
+    Q_INVOKABLE QString body(int row) const {
+        if (row < 0 || row >= (int)m_rows.size()) return QString();
+        if (row == 0) return QStringLiteral("주식 시장 개장을 준비 중입니다.");
+        const Row& r = m_rows[row];
+        if (r.begin == r.end) return QStringLiteral("오늘은 특별한 소식이 없습니다.");
+        m_buffer.clear();
+        for (uint32_t i = r.begin; i < r.end; i++) {
+            m_buffer += "- ";
+            m_market->appendNewsText(m_items[i], m_buffer);
+            m_buffer += "\n\n";
+        }
+        return QString::fromUtf8(m_buffer.data(), (qsizetype)m_buffer.size());
+    }
+
+signals:
+    void countChanged();
+
+private:
+    struct Row {
+        int day;
+        uint32_t begin; //m_items 안의 구간
+        uint32_t end;
+    };
+
+    const Market* m_market; //문장/회사 이름을 읽을 시나리오 (앞 버퍼)
+    QVector<Row> m_rows;
+    vector<NewsItem> m_items; //모든 날의 뉴스 ID
+    mutable string m_buffer; //본문 조립용 (용량을 재사용)
+};
+
+#endif // NEWSHISTORYMODEL_H
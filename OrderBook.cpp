@@ -0,0 +1,107 @@
+﻿#include "OrderBook.h"
+
+uint32_t OrderBook::allocate() {
+    if (m_free != Nil) {
+        const uint32_t node = m_free;
+        m_free = m_nodes[node].next;
+        return node;
+    }
+    m_nodes.push_back({ 0, 0, Nil, Nil, 0, 1, Buy });
+    return (uint32_t)(m_nodes.size() - 1);
+}
+
+void OrderBook::release(uint32_t node) {
+    Node& n = m_nodes[node];
+    n.quantity = 0;
+    n.generation++; //예전 주문 번호를 무효화
+    if (n.generation == 0) n.generation = 1; //번호가 NoOrder(0)가 되지 않도록
+    n.next = m_free;
+    m_free = node;
+    m_live--;
+}
+
+const OrderBook::Node* OrderBook::lookup(OrderId id) const {
+    const uint32_t node = uint32_t(id);
+    if (node >= m_nodes.size()) return nullptr;
+    const Node& n = m_nodes[node];
+    if (n.generation != uint32_t(id >> 32) || n.quantity == 0) return nullptr;
+    return &n;
+}
+
+//가격 레벨 위치 (없으면 들어갈 위치). 새 주문은 최우선 호가 근처가 많으므로 끝부터 확인합니다.
+size_t OrderBook::findLevel(const vector<Level>& book, Side side, int64_t price) const {
+    //"a가 b보다 끝쪽(더 좋은 호가)" 순서로 정렬되어 있음
+    auto before = [side](int64_t a, int64_t b) { return side == Buy ? a < b : a > b; };
+    size_t n = book.size();
+    if (n == 0 || before(book[n - 1].price, price)) return n;
+    if (book[n - 1].price == price) return n - 1;
+    size_t lo = 0, hi = n - 1;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (before(book[mid].price, price)) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+OrderBook::OrderId OrderBook::rest(Side side, int64_t price, int64_t quantity, uint32_t owner) {
+    if (quantity <= 0 || price <= 0) return NoOrder;
+    vector<Level>& book = (side == Buy) ? m_bids : m_asks;
+    const size_t at = findLevel(book, side, price);
+    if (at == book.size() || book[at].price != price) book.insert(book.begin() + at, Level{ price, 0, Nil, Nil });
+
+    const uint32_t node = allocate();
+    Node& n = m_nodes[node];
+    Level& level = book[at];
+    n.price = price;
+    n.quantity = quantity;
+    n.owner = owner;
+    n.side = side;
+    n.prev = level.tail;
+    n.next = Nil;
+    if (level.tail != Nil) m_nodes[level.tail].next = node;
+    else level.head = node;
+    level.tail = node;
+    level.quantity += quantity;
+    m_live++;
+    return idOf(node);
+}
+
+bool OrderBook::cancel(OrderId id, int64_t* remaining) {
+    const Node* found = lookup(id);
+    if (!found) return false;
+    const uint32_t node = uint32_t(id);
+    Node& n = m_nodes[node];
+    vector<Level>& book = (n.side == Buy) ? m_bids : m_asks;
+    const size_t at = findLevel(book, n.side, n.price);
+    Level& level = book[at];
+
+    if (n.prev != Nil) m_nodes[n.prev].next = n.next;
+    else level.head = n.next;
+    if (n.next != Nil) m_nodes[n.next].prev = n.prev;
+    else level.tail = n.prev;
+    level.quantity -= n.quantity;
+    if (remaining) *remaining = n.quantity;
+    if (level.head == Nil) book.erase(book.begin() + at);
+    release(node);
+    return true;
+}
+
+int64_t OrderBook::remaining(OrderId id) const {
+    const Node* n = lookup(id);
+    return n ? n->quantity : 0;
+}
+
+void OrderBook::clear() {
+    //노드 배열은 남겨 두고 전부 빈 목록으로 (세대는 올려서 예전 번호를 무효화)
+    m_bids.clear();
+    m_asks.clear();
+    m_free = Nil;
+    for (size_t i = m_nodes.size(); i-- > 0;) {
+        Node& n = m_nodes[i];
+        if (n.quantity != 0) { n.quantity = 0; n.generation = (n.generation + 1) ? n.generation + 1 : 1; }
+        n.next = m_free;
+        m_free = (uint32_t)i;
+    }
+    m_live = 0;
+}
@@ -0,0 +1,151 @@
+﻿#ifndef ORDERBOOK_H
+#define ORDERBOOK_H
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace std;
+
+// 한 종목의 지정가 주문장 (가격-시간 우선)
+// 가격은 정수 틱(원), 수량은 정수 주. 같은 가격의 주문은 들어온 순서대로 체결됩니다.
+// 호가(가격 레벨)는 쪽마다 정렬된 배열 하나에 모아 두고 최우선 호가를 배열 끝에 둡니다.
+// 체결로 레벨이 비면 pop_back, 새 호가는 대부분 끝 근처에 들어가므로 옮기는 양이 적습니다.
+// 주문 노드는 풀에서 재사용하고 레벨마다 이중 연결 리스트(FIFO)로 이어서 취소도 O(1)에 뺍니다.
+class OrderBook {
+public:
+    enum Side : uint8_t { Buy = 0, Sell = 1 };
+
+    //(세대 << 32) | 노드 번호. 노드를 재사용해도 예전 번호로는 찾을 수 없고, 해시 없이 바로 찾습니다.
+    using OrderId = uint64_t;
+    static constexpr OrderId NoOrder = 0;
+
+    //시장가 주문의 한도 (반대쪽 호가를 끝까지 훑음)
+    static constexpr int64_t MarketBuy = numeric_limits<int64_t>::max();
+    static constexpr int64_t MarketSell = 0;
+    static constexpr int64_t NoBudget = numeric_limits<int64_t>::max();
+
+    struct Level {
+        int64_t price;
+        int64_t quantity; //레벨 전체 잔량
+        uint32_t head, tail; //가장 먼저/나중에 들어온 주문 노드
+    };
+
+    //체결 한 건 (가격은 주문장에 먼저 있던 주문의 가격)
+    struct Fill {
+        OrderId maker;
+        uint32_t makerOwner;
+        int64_t price;
+        int64_t quantity;
+        bool makerDone; //maker 주문이 전부 체결되어 주문장에서 빠졌는지
+    };
+
+    struct Result {
+        int64_t filled = 0;
+        int64_t cost = 0; //체결 금액 합계 (가격 × 수량)
+        int64_t lastPrice = 0; //마지막 체결 가격 (체결이 없으면 0)
+        OrderId resting = NoOrder; //주문장에 남은 주문 (전부 체결됐거나 시장가면 NoOrder)
+    };
+
+    //들어온 주문을 반대쪽 호가와 체결하고 남은 수량은 주문장에 올립니다.
+    //onFill(const Fill&)은 체결마다 불리며, 그 안에서 이 주문장을 바꾸면 안 됩니다.
+    template<class OnFill>
+    Result submitLimit(Side side, int64_t price, int64_t quantity, uint32_t owner, OnFill&& onFill) {
+        Result r = match(side, price, quantity, NoBudget, onFill);
+        if (quantity > r.filled) r.resting = rest(side, price, quantity - r.filled, owner);
+        return r;
+    }
+
+    //시장가 주문: 체결되지 않은 수량은 버립니다. budget은 매수에 쓸 수 있는 최대 금액입니다.
+    template<class OnFill>
+    Result submitMarket(Side side, int64_t quantity, OnFill&& onFill, int64_t budget = NoBudget) {
+        return match(side, side == Buy ? MarketBuy : MarketSell, quantity, budget, onFill);
+    }
+
+    //체결 없이 주문장 맨 뒤에 올림 (시장 조성 호가, 저장된 주문장 복원용)
+    OrderId rest(Side side, int64_t price, int64_t quantity, uint32_t owner);
+    //남은 수량을 돌려주고 주문장에서 뺌 (이미 체결/취소된 주문이면 false)
+    bool cancel(OrderId id, int64_t* remaining = nullptr);
+    //남은 수량 (없는 주문이면 0)
+    int64_t remaining(OrderId id) const;
+    void clear();
+
+    bool empty() const { return m_bids.empty() && m_asks.empty(); }
+    size_t orderCount() const { return m_live; }
+    int64_t bestBid() const { return m_bids.empty() ? 0 : m_bids.back().price; }
+    int64_t bestAsk() const { return m_asks.empty() ? 0 : m_asks.back().price; }
+    //최우선 호가가 맨 뒤 (매수: 가격 오름차순, 매도: 내림차순)
+    const vector<Level>& levels(Side side) const { return side == Buy ? m_bids : m_asks; }
+
+    //한쪽 주문을 체결 우선순위대로 훑음: fn(OrderId, price, quantity, owner)
+    template<class Fn>
+    void forEachOrder(Side side, Fn&& fn) const {
+        const vector<Level>& book = levels(side);
+        for (size_t l = book.size(); l-- > 0;) {
+            for (uint32_t i = book[l].head; i != Nil; i = m_nodes[i].next)
+                fn(idOf(i), book[l].price, m_nodes[i].quantity, m_nodes[i].owner);
+        }
+    }
+
+private:
+    static constexpr uint32_t Nil = 0xFFFFFFFFu;
+
+    struct Node {
+        int64_t price;
+        int64_t quantity; //0이면 빈 노드
+        uint32_t prev, next; //같은 레벨 안의 앞뒤 (빈 노드는 next가 빈 목록 연결)
+        uint32_t owner;
+        uint32_t generation;
+        Side side;
+    };
+
+    vector<Level> m_bids, m_asks;
+    vector<Node> m_nodes;
+    uint32_t m_free = Nil;
+    size_t m_live = 0;
+
+    OrderId idOf(uint32_t node) const { return (OrderId(m_nodes[node].generation) << 32) | node; }
+    const Node* lookup(OrderId id) const;
+    uint32_t allocate();
+    void release(uint32_t node);
+    size_t findLevel(const vector<Level>& book, Side side, int64_t price) const;
+
+    template<class OnFill>
+    Result match(Side side, int64_t limit, int64_t quantity, int64_t budget, OnFill& onFill) {
+        Result r;
+        vector<Level>& book = (side == Buy) ? m_asks : m_bids;
+        while (r.filled < quantity && !book.empty()) {
+            Level& level = book.back();
+            if (side == Buy ? level.price > limit : level.price < limit) break;
+            int64_t want = quantity - r.filled;
+            if (budget != NoBudget) {
+                const int64_t affordable = (budget - r.cost) / level.price;
+                if (affordable < want) want = affordable;
+                if (want <= 0) break;
+            }
+            while (want > 0 && level.head != Nil) {
+                const uint32_t index = level.head;
+                Node& node = m_nodes[index];
+                const int64_t q = node.quantity < want ? node.quantity : want;
+                Fill fill{ idOf(index), node.owner, level.price, q, q == node.quantity };
+                node.quantity -= q;
+                level.quantity -= q;
+                want -= q;
+                r.filled += q;
+                r.cost += q * level.price;
+                r.lastPrice = level.price;
+                if (fill.makerDone) {
+                    level.head = node.next;
+                    if (level.head != Nil) m_nodes[level.head].prev = Nil;
+                    else level.tail = Nil;
+                    release(index);
+                }
+                onFill(fill);
+            }
+            if (level.head == Nil) book.pop_back();
+        }
+        return r;
+    }
+};
+
+#endif // ORDERBOOK_H
@@ -0,0 +1,307 @@
+﻿#include "PriceChart.h"
+#include "GameBackend.h"
+#include <QSGFlatColorMaterial>
+#include <QSGGeometryNode>
+#include <QSGVertexColorMaterial>
+
+namespace {
+
+//기록의 begin일부터 끝까지를 하루씩 붙임 (봉으로 묶인 오래된 날은 그 봉을 날 수만큼)
+void appendHistory(MinMaxDownsampler& out, const PriceHistory& history, size_t begin) {
+    history.visit(begin, history.size(), [&out](const PriceHistory::Bucket& b, size_t days) {
+        for (size_t d = 0; d < days; d++) out.append(b);
+    });
+}
+
+}
+
+PriceChart::PriceChart(QQuickItem *parent) : QQuickItem(parent) {
+    setFlag(ItemHasContents, true);
+}
+
+QObject* PriceChart::source() const {
+    return m_backend.data();
+}
+
+void PriceChart::setSource(QObject* source) {
+    GameBackend* backend = qobject_cast<GameBackend*>(source);
+    if (m_backend == backend) return;
+    if (m_backend) disconnect(m_backend, nullptr, this, nullptr);
+    m_backend = backend;
+    //거래/턴 진행 모두 dataChanged를 보내므로, 그때마다 새로 생긴 점만 확인
+    if (m_backend) connect(m_backend, &GameBackend::dataChanged, this, &PriceChart::appendNew);
+    rebuild();
+    emit sourceChanged();
+}
+
+void PriceChart::setStockIndex(int index) {
+    if (m_stockIndex == index) return;
+    m_stockIndex = index;
+    rebuild();
+    emit stockIndexChanged();
+}
+
+void PriceChart::setLineColor(const QColor& color) {
+    if (m_lineColor == color) return;
+    m_lineColor = color;
+    m_colorDirty = true;
+    update();
+    emit lineColorChanged();
+}
+
+void PriceChart::setDownColor(const QColor& color) {
+    if (m_downColor == color) return;
+    m_downColor = color;
+    update();
+    emit lineColorChanged();
+}
+
+void PriceChart::setStyle(Style style) {
+    if (m_style == style) return;
+    m_style = style;
+    rebuild();
+    emit styleChanged();
+}
+
+void PriceChart::setVisibleBars(int count) {
+    if (m_visibleBars == count) return;
+    m_visibleBars = count;
+    if (m_style == Intraday) rebuild();
+    emit styleChanged();
+}
+
+void PriceChart::setShowAverages(bool show) {
+    if (m_showAverages == show) return;
+    m_showAverages = show;
+    rebuild();
+    emit styleChanged();
+}
+
+void PriceChart::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) {
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    //가로 픽셀 수가 바뀌면 구간 수도 바뀜 (캔들은 최소 3픽셀 폭)
+    const double pixels = (m_style == Line) ? newGeometry.width() : newGeometry.width() / 3;
+    if ((size_t)qMax(2.0, pixels) != m_series.capacity()) rebuild();
+}
+
+void PriceChart::rebuild() {
+    m_series.setCapacity((size_t)qMax(2.0, m_style == Line ? width() : width() / 3));
+    m_sma.setCapacity(m_series.capacity());
+    m_ema.setCapacity(m_series.capacity());
+    m_lastPrice = 0;
+    if (m_backend && m_stockIndex >= 0 && m_stockIndex < m_backend->companyCount()) {
+        if (m_style == Line) {
+            const PriceHistory& history = m_backend->history(m_stockIndex);
+            appendHistory(m_series, history, 0);
+            if (!history.empty()) m_lastPrice = history.back();
+            if (averagesVisible()) {
+                appendHistory(m_sma, m_backend->smaSeries(m_stockIndex), 0);
+                appendHistory(m_ema, m_backend->emaSeries(m_stockIndex), 0);
+            }
+        } else {
+            const Bar* bars = nullptr;
+            size_t count = 0;
+            if (m_style == Candles) {
+                bars = m_backend->candles(m_stockIndex).data();
+                count = m_backend->candles(m_stockIndex).size();
+            } else {
+                bars = m_backend->intradayBars(m_stockIndex);
+                count = (size_t)m_backend->intradayBarCount();
+                if (m_visibleBars >= 0) count = qMin(count, (size_t)m_visibleBars);
+            }
+            for (size_t i = 0; i < count; i++) m_series.append({ bars[i].low, bars[i].high, bars[i].open, bars[i].close });
+            if (count > 0) m_lastPrice = bars[count - 1].close;
+        }
+    }
+    update();
+    emit seriesChanged();
+}
+
+void PriceChart::appendNew() {
+    if (!m_backend || m_stockIndex < 0 || m_stockIndex >= m_backend->companyCount()) return;
+    //장중 봉은 매일 통째로 바뀜
+    if (m_style == Intraday) { rebuild(); return; }
+    if (m_style == Candles) {
+        const vector<Bar>& candles = m_backend->candles(m_stockIndex);
+        if (candles.size() < m_series.count() || (candles.size() == m_series.count() && !candles.empty() &&
+                                                  candles.back().close != m_lastPrice)) { rebuild(); return; }
+        if (candles.size() == m_series.count()) return;
+        for (size_t i = m_series.count(); i < candles.size(); i++)
+            m_series.append({ candles[i].low, candles[i].high, candles[i].open, candles[i].close });
+        m_lastPrice = candles.back().close;
+        update();
+        emit seriesChanged();
+        return;
+    }
+    const PriceHistory& history = m_backend->history(m_stockIndex);
+    //기록이 줄었다면 다른 게임으로 바뀐 것이므로 처음부터 다시
+    if (history.size() < m_series.count()) { rebuild(); return; }
+    if (history.size() == m_series.count()) {
+        //거래 체결로 오늘 가격만 바뀐 경우 (마지막 구간을 다시 계산)
+        if (!history.empty() && history.back() != m_lastPrice) rebuild();
+        return;
+    }
+    appendHistory(m_series, history, m_series.count());
+    if (averagesVisible()) {
+        //지표 값은 history와 같은 날짜에 하나씩 붙음 (지표가 꺼져 있으면 비어 있음)
+        appendHistory(m_sma, m_backend->smaSeries(m_stockIndex), m_sma.count());
+        appendHistory(m_ema, m_backend->emaSeries(m_stockIndex), m_ema.count());
+    }
+    m_lastPrice = history.back();
+    update();
+    emit seriesChanged();
+}
+
+//선 노드, 캔들 노드, 오버레이 선 노드 둘을 모두 두고, 지금 그리지 않는 쪽은 정점 0개로 비워 둠
+//자식 순서: 0 = 종가 선, 1 = 캔들, 2 = 이동평균, 3 = 지수이동평균
+QSGNode *PriceChart::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) {
+    QSGNode *root = oldNode;
+    if (!root) {
+        root = new QSGNode;
+        auto lineNode = [](float lineWidth, const QColor& color) {
+            QSGGeometryNode *node = new QSGGeometryNode;
+            QSGGeometry *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+            geometry->setDrawingMode(QSGGeometry::DrawLineStrip);
+            geometry->setLineWidth(lineWidth);
+            node->setGeometry(geometry);
+            node->setFlag(QSGNode::OwnsGeometry);
+            QSGFlatColorMaterial *material = new QSGFlatColorMaterial;
+            material->setColor(color);
+            node->setMaterial(material);
+            node->setFlag(QSGNode::OwnsMaterial);
+            return node;
+        };
+        root->appendChildNode(lineNode(2, m_lineColor));
+
+        QSGGeometryNode *candles = new QSGGeometryNode;
+        QSGGeometry *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), 0);
+        geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+        candles->setGeometry(geometry);
+        candles->setFlag(QSGNode::OwnsGeometry);
+        candles->setMaterial(new QSGVertexColorMaterial);
+        candles->setFlag(QSGNode::OwnsMaterial);
+        root->appendChildNode(candles);
+        root->appendChildNode(lineNode(1, m_smaColor));
+        root->appendChildNode(lineNode(1, m_emaColor));
+        m_colorDirty = true;
+    }
+    QSGGeometryNode *line = static_cast<QSGGeometryNode *>(root->childAtIndex(0));
+    QSGGeometryNode *candles = static_cast<QSGGeometryNode *>(root->childAtIndex(1));
+    QSGGeometryNode *sma = static_cast<QSGGeometryNode *>(root->childAtIndex(2));
+    QSGGeometryNode *ema = static_cast<QSGGeometryNode *>(root->childAtIndex(3));
+    if (m_colorDirty) {
+        static_cast<QSGFlatColorMaterial *>(line->material())->setColor(m_lineColor);
+        line->markDirty(QSGNode::DirtyMaterial);
+        m_colorDirty = false;
+    }
+
+    auto empty = [](QSGGeometryNode *node) {
+        node->geometry()->allocate(0);
+        node->markDirty(QSGNode::DirtyGeometry);
+    };
+    if (m_style == Line) {
+        fillLine(line, m_series);
+        empty(candles);
+    } else {
+        fillCandles(candles);
+        empty(line);
+    }
+    if (averagesVisible()) {
+        fillLine(sma, m_sma);
+        fillLine(ema, m_ema);
+    } else {
+        empty(sma);
+        empty(ema);
+    }
+    return root;
+}
+
+//위아래 10% 여유 (값이 모두 같으면 값의 10%), 오버레이를 켰으면 평균선도 범위에 넣음
+void PriceChart::priceRange(double& minVal, double& range) const {
+    minVal = m_series.minValue();
+    double maxVal = m_series.maxValue();
+    if (averagesVisible()) {
+        for (const MinMaxDownsampler* overlay : { &m_sma, &m_ema }) {
+            if (overlay->count() == 0) continue;
+            minVal = qMin(minVal, overlay->minValue());
+            maxVal = qMax(maxVal, overlay->maxValue());
+        }
+    }
+    range = maxVal - minVal;
+    double buffer = (range == 0) ? maxVal * 0.1 : range * 0.1;
+    minVal -= buffer; maxVal += buffer;
+    range = (maxVal - minVal) == 0 ? 1.0 : (maxVal - minVal);
+}
+
+void PriceChart::fillLine(QSGGeometryNode *node, const MinMaxDownsampler& series) {
+    const auto& buckets = series.buckets();
+    const size_t count = series.count();
+    const size_t span = series.span();
+    //구간 하나에 점이 하나면 정점 1개, 여러 개면 최소/최대 정점 2개
+    const int perBucket = (span == 1) ? 1 : 2;
+
+    QSGGeometry *geometry = node->geometry();
+    geometry->allocate((int)buckets.size() * perBucket);
+    QSGGeometry::Point2D *v = geometry->vertexDataAsPoint2D();
+
+    if (!buckets.empty()) {
+        double minVal, range;
+        priceRange(minVal, range);
+
+        const double w = width(), h = height();
+        const double lastIndex = (count > 1) ? double(count - 1) : 1.0;
+        auto yOf = [&](double value) { return float(h - (value - minVal) / range * h); };
+
+        for (size_t b = 0; b < buckets.size(); b++) {
+            const auto& bucket = buckets[b];
+            //구간에 속한 데이터의 가운데 위치
+            size_t first = b * span;
+            size_t last = min(count, first + span) - 1;
+            float x = float((first + last) * 0.5 / lastIndex * w);
+            if (perBucket == 1) {
+                v++->set(x, yOf(bucket.last));
+            } else if (bucket.first <= bucket.last) {
+                v++->set(x, yOf(bucket.min));
+                v++->set(x, yOf(bucket.max));
+            } else {
+                v++->set(x, yOf(bucket.max));
+                v++->set(x, yOf(bucket.min));
+            }
+        }
+    }
+    node->markDirty(QSGNode::DirtyGeometry);
+}
+
+//캔들 하나 = 꼬리 사각형 + 몸통 사각형 (삼각형 4개, 정점 12개), 구간 폭을 칸 너비로 씀
+void PriceChart::fillCandles(QSGGeometryNode *node) {
+    const auto& buckets = m_series.buckets();
+    QSGGeometry *geometry = node->geometry();
+    geometry->allocate((int)buckets.size() * 12);
+    QSGGeometry::ColoredPoint2D *v = geometry->vertexDataAsColoredPoint2D();
+
+    if (!buckets.empty()) {
+        double minVal, range;
+        priceRange(minVal, range);
+
+        const double h = height();
+        const float slot = float(width() / double(buckets.size()));
+        const float body = qMax(1.0f, slot * 0.7f);
+        auto yOf = [&](double value) { return float(h - (value - minVal) / range * h); };
+        auto quad = [&v](float x0, float y0, float x1, float y1, const QColor& c) {
+            const uchar r = uchar(c.red()), g = uchar(c.green()), b = uchar(c.blue()), a = uchar(c.alpha());
+            v++->set(x0, y0, r, g, b, a); v++->set(x1, y0, r, g, b, a); v++->set(x0, y1, r, g, b, a);
+            v++->set(x1, y0, r, g, b, a); v++->set(x1, y1, r, g, b, a); v++->set(x0, y1, r, g, b, a);
+        };
+
+        for (size_t b = 0; b < buckets.size(); b++) {
+            const auto& bucket = buckets[b];
+            const QColor& color = (bucket.last >= bucket.first) ? m_lineColor : m_downColor;
+            const float x = slot * (float(b) + 0.5f);
+            quad(x - 0.5f, yOf(bucket.max), x + 0.5f, yOf(bucket.min), color);
+            float top = yOf(qMax(bucket.first, bucket.last)), bottom = yOf(qMin(bucket.first, bucket.last));
+            if (bottom - top < 1.0f) bottom = top + 1.0f; //시가 = 종가여도 한 줄은 보이도록
+            quad(x - body / 2, top, x + body / 2, bottom, color);
+        }
+    }
+    node->markDirty(QSGNode::DirtyGeometry);
+}
@@ -0,0 +1,97 @@
+﻿#ifndef PRICECHART_H
+#define PRICECHART_H
+
+#include <QColor>
+#include <QPointer>
+#include <QQuickItem>
+#include <QtQml/qqmlregistration.h>
+#include "Downsampler.h"
+
+class GameBackend;
+class QSGGeometryNode;
+
+// 주가 차트 (씬 그래프 직접 그리기)
+// 백엔드의 history를 복사 없이 구간 단위로 읽어서 픽셀 단위 최소/최대 구간으로 묶고,
+// 턴이 지나면 새로 생긴 점만 이어 붙입니다. 그리는 정점 수는 차트 너비에만 비례합니다.
+// 장중 모드에서는 일봉이나 오늘의 장중 봉을 캔들로 그릴 수 있습니다. (봉도 같은 구간 방식으로 합쳐짐)
+// 선 차트에는 이동평균/지수이동평균을 겹쳐 그릴 수 있고, 세 선은 같은 가격 축을 씁니다.
+class PriceChart : public QQuickItem {
+    Q_OBJECT
+    QML_ELEMENT
+    Q_PROPERTY(QObject* source READ source WRITE setSource NOTIFY sourceChanged)
+    Q_PROPERTY(int stockIndex READ stockIndex WRITE setStockIndex NOTIFY stockIndexChanged)
+    Q_PROPERTY(QColor lineColor READ lineColor WRITE setLineColor NOTIFY lineColorChanged)
+    Q_PROPERTY(QColor downColor READ downColor WRITE setDownColor NOTIFY lineColorChanged)
+    Q_PROPERTY(Style style READ style WRITE setStyle NOTIFY styleChanged)
+    Q_PROPERTY(int visibleBars READ visibleBars WRITE setVisibleBars NOTIFY styleChanged)
+    Q_PROPERTY(bool showAverages READ showAverages WRITE setShowAverages NOTIFY styleChanged)
+    Q_PROPERTY(int pointCount READ pointCount NOTIFY seriesChanged)
+    Q_PROPERTY(double minPrice READ minPrice NOTIFY seriesChanged)
+    Q_PROPERTY(double maxPrice READ maxPrice NOTIFY seriesChanged)
+    Q_PROPERTY(double lastPrice READ lastPrice NOTIFY seriesChanged)
+
+public:
+    //Line: 종가 선, Candles: 일봉, Intraday: 오늘의 장중 봉
+    enum Style { Line, Candles, Intraday };
+    Q_ENUM(Style)
+
+    explicit PriceChart(QQuickItem *parent = nullptr);
+
+    QObject* source() const;
+    void setSource(QObject* source);
+    int stockIndex() const { return m_stockIndex; }
+    void setStockIndex(int index);
+    QColor lineColor() const { return m_lineColor; }
+    void setLineColor(const QColor& color);
+    QColor downColor() const { return m_downColor; }
+    void setDownColor(const QColor& color);
+    Style style() const { return m_style; }
+    void setStyle(Style style);
+    //장중 봉을 앞에서부터 몇 개만 그릴지 (-1이면 전부, 하루 진행을 애니메이션으로 보여줄 때 사용)
+    int visibleBars() const { return m_visibleBars; }
+    void setVisibleBars(int count);
+    //선 차트에 이동평균(SMA)/지수이동평균(EMA) 겹쳐 그리기 (지표가 꺼져 있으면 그릴 것이 없음)
+    bool showAverages() const { return m_showAverages; }
+    void setShowAverages(bool show);
+
+    int pointCount() const { return (int)m_series.count(); }
+    double minPrice() const { return m_series.minValue(); }
+    double maxPrice() const { return m_series.maxValue(); }
+    double lastPrice() const { return m_lastPrice; }
+
+signals:
+    void sourceChanged();
+    void stockIndexChanged();
+    void lineColorChanged();
+    void styleChanged();
+    void seriesChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) override;
+    void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+
+private:
+    QPointer<GameBackend> m_backend;
+    int m_stockIndex = -1;
+    QColor m_lineColor = QColor("#ff4d4d");
+    QColor m_downColor = QColor("#4d79ff");
+    Style m_style = Line;
+    int m_visibleBars = -1;
+    bool m_showAverages = false;
+    MinMaxDownsampler m_series;
+    MinMaxDownsampler m_sma; //오버레이 (m_series와 같은 구간 수)
+    MinMaxDownsampler m_ema;
+    QColor m_smaColor = QColor("#ffb74d");
+    QColor m_emaColor = QColor("#4dd0e1");
+    double m_lastPrice = 0;
+    bool m_colorDirty = true;
+
+    void rebuild(); //history(또는 봉) 전체를 다시 묶음 (종목/크기/스타일 변경 시)
+    void appendNew(); //새로 생긴 점/봉만 이어 붙임 (턴 진행 시)
+    bool averagesVisible() const { return m_showAverages && m_style == Line; }
+    void priceRange(double& minVal, double& range) const; //세로 축 (여유 포함)
+    void fillLine(QSGGeometryNode *node, const MinMaxDownsampler& series);
+    void fillCandles(QSGGeometryNode *node);
+};
+
+#endif // PRICECHART_H
@@ -0,0 +1,190 @@
+﻿#include "PriceHistory.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+uint64_t toBits(double v) { uint64_t b; memcpy(&b, &v, sizeof b); return b; }
+double fromBits(uint64_t b) { double v; memcpy(&v, &b, sizeof v); return v; }
+
+//x != 0
+int leadingZeros(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(x);
+#else
+    int n = 0;
+    while (!(x & (uint64_t(1) << 63))) { x <<= 1; n++; }
+    return n;
+#endif
+}
+
+int trailingZeros(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    while (!(x & 1)) { x >>= 1; n++; }
+    return n;
+#endif
+}
+
+//n비트(1~64)를 비트열 뒤에 붙임
+void writeBits(vector<uint64_t>& words, uint32_t& bits, uint64_t value, int n) {
+    const int used = (int)(bits & 63);
+    if (used == 0) words.push_back(0);
+    if (n < 64) value &= (uint64_t(1) << n) - 1;
+    const int free = 64 - used;
+    if (n <= free) {
+        words.back() |= value << (free - n);
+    } else {
+        words.back() |= value >> (n - free);
+        words.push_back(value << (64 - (n - free)));
+    }
+    bits += (uint32_t)n;
+}
+
+uint64_t readBits(const uint64_t* words, uint32_t& pos, int n) {
+    const uint32_t word = pos >> 6;
+    const int used = (int)(pos & 63);
+    const int free = 64 - used;
+    uint64_t v = (words[word] << used) >> (64 - n);
+    if (n > free) v |= words[word + 1] >> (64 - (n - free));
+    pos += (uint32_t)n;
+    return v;
+}
+
+}
+
+PriceHistory::PriceHistory(const HistoryConfig& config) : m_config(config) {
+    m_config.recentDays = max(2, m_config.recentDays);
+    m_config.chunkDays = max(1, m_config.chunkDays);
+    m_config.maxChunks = max(0, m_config.maxChunks);
+    m_config.rollupBars = max(2, m_config.rollupBars);
+    m_rollup.setCapacity((size_t)m_config.rollupBars);
+}
+
+void PriceHistory::push(double price) {
+    const size_t capacity = (size_t)m_config.recentDays;
+    if (m_recent.size() < capacity) {
+        m_recent.push_back(price);
+        return;
+    }
+    const double oldest = m_recent[m_recentStart];
+    m_recent[m_recentStart] = price;
+    m_recentStart = (m_recentStart + 1) % capacity;
+    spill(oldest);
+}
+
+void PriceHistory::spill(double price) {
+    m_scratchChunk = NoChunk; //청크가 바뀌므로 풀어 둔 값은 버림
+    if (m_config.maxChunks == 0) {
+        m_rollup.append(price);
+        return;
+    }
+    if (m_chunks.empty() || m_chunks.back().count == (uint32_t)m_config.chunkDays) {
+        if (!m_chunks.empty()) m_chunks.back().words.shrink_to_fit();
+        //청크가 상한이면 가장 오래된 청크를 풀어 봉으로
+        if (m_chunks.size() == (size_t)m_config.maxChunks) {
+            const uint32_t count = m_chunks.front().count;
+            const double* values = decoded(0);
+            for (uint32_t i = 0; i < count; i++) m_rollup.append(values[i]);
+            m_chunkedDays -= count;
+            m_chunks.erase(m_chunks.begin());
+            m_scratchChunk = NoChunk;
+        }
+        m_chunks.emplace_back();
+        m_lead = -1;
+    }
+    encode(m_chunks.back(), price);
+    m_chunkedDays++;
+}
+
+//Gorilla XOR 인코딩: 첫 값은 64비트 그대로, 이후는 이전 값과의 XOR를
+//  0                            → 같은 값
+//  10 + 유효 비트               → 이전과 같은 앞/뒤 0 구간 안에 들어감
+//  11 + 앞 0 수(5) + 길이-1(6) + 유효 비트 → 새 구간
+void PriceHistory::encode(Chunk& chunk, double price) {
+    const uint64_t bits = toBits(price);
+    if (chunk.count++ == 0) {
+        writeBits(chunk.words, chunk.bits, bits, 64);
+        m_prevBits = bits;
+        return;
+    }
+    const uint64_t x = bits ^ m_prevBits;
+    m_prevBits = bits;
+    if (x == 0) {
+        writeBits(chunk.words, chunk.bits, 0, 1);
+        return;
+    }
+    const int lead = min(31, leadingZeros(x));
+    const int trail = trailingZeros(x);
+    if (m_lead >= 0 && lead >= m_lead && trail >= m_trail) {
+        writeBits(chunk.words, chunk.bits, 0b10, 2);
+        writeBits(chunk.words, chunk.bits, x >> m_trail, 64 - m_lead - m_trail);
+        return;
+    }
+    const int significant = 64 - lead - trail;
+    writeBits(chunk.words, chunk.bits, 0b11, 2);
+    writeBits(chunk.words, chunk.bits, (uint64_t)lead, 5);
+    writeBits(chunk.words, chunk.bits, (uint64_t)(significant - 1), 6);
+    writeBits(chunk.words, chunk.bits, x >> trail, significant);
+    m_lead = lead;
+    m_trail = trail;
+}
+
+void PriceHistory::decode(const Chunk& chunk, double* out) const {
+    if (chunk.count == 0) return;
+    const uint64_t* words = chunk.words.data();
+    uint32_t pos = 0;
+    uint64_t prev = readBits(words, pos, 64);
+    out[0] = fromBits(prev);
+    int lead = 0, trail = 0;
+    for (uint32_t i = 1; i < chunk.count; i++) {
+        if (readBits(words, pos, 1)) {
+            if (readBits(words, pos, 1)) {
+                lead = (int)readBits(words, pos, 5);
+                const int significant = (int)readBits(words, pos, 6) + 1;
+                trail = 64 - lead - significant;
+            }
+            prev ^= readBits(words, pos, 64 - lead - trail) << trail;
+        }
+        out[i] = fromBits(prev);
+    }
+}
+
+const double* PriceHistory::decoded(size_t chunk) const {
+    if (m_scratchChunk != chunk) {
+        m_scratch.resize((size_t)m_config.chunkDays);
+        decode(m_chunks[chunk], m_scratch.data());
+        m_scratchChunk = chunk;
+    }
+    return m_scratch.data();
+}
+
+double PriceHistory::at(size_t day) const {
+    const size_t rolled = m_rollup.count();
+    if (day < rolled) return m_rollup.buckets()[day / m_rollup.span()].last;
+    day -= rolled;
+    if (day >= m_chunkedDays) return recent(day - m_chunkedDays);
+    return decoded(day / (size_t)m_config.chunkDays)[day % (size_t)m_config.chunkDays];
+}
+
+void PriceHistory::copy(size_t begin, size_t end, vector<double>& out) const {
+    visit(begin, end, [&out](const Bucket& b, size_t days) { out.insert(out.end(), days, b.last); });
+}
+
+bool PriceHistory::restore(const Bucket* buckets, size_t bucketCount, size_t span, size_t rolledDays,
+                           const double* exact, size_t exactCount) {
+    *this = PriceHistory(m_config);
+    if (!m_rollup.restore(buckets, bucketCount, span, rolledDays)) return false;
+    for (size_t i = 0; i < exactCount; i++) push(exact[i]);
+    return true;
+}
+
+size_t PriceHistory::memoryBytes() const {
+    size_t bytes = sizeof(*this) + m_recent.capacity() * sizeof(double) +
+                   m_rollup.buckets().capacity() * sizeof(Bucket) + m_chunks.capacity() * sizeof(Chunk) +
+                   m_scratch.capacity() * sizeof(double);
+    for (const Chunk& c : m_chunks) bytes += c.words.capacity() * sizeof(uint64_t);
+    return bytes;
+}
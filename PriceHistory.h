@@ -0,0 +1,132 @@
+﻿#ifndef PRICEHISTORY_H
+#define PRICEHISTORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Downsampler.h"
+
+using namespace std;
+
+// 회사 하나의 종가 기록 (메모리 상한이 있는 3단 저장)
+// 최근 recentDays일은 링 버퍼에 원본 그대로, 그보다 오래된 날은 chunkDays일씩 XOR 부동소수 압축(Gorilla 방식,
+// 무손실) 청크로, 청크가 maxChunks개를 넘으면 가장 오래된 청크를 풀어 봉(최저/최고/처음/마지막)으로 묶습니다.
+// 봉은 rollupBars개를 넘으면 이웃 둘을 합쳐 폭을 2배로 늘리므로(MinMaxDownsampler), 게임이 아무리 길어져도
+// 회사당 메모리는 거의 일정합니다. 날짜 번호는 처음 넣은 값이 0이고, 봉으로 묶인 날은 하루 단위 값이 없습니다.
+// 기본값이면 1280일까지는 모든 날이 원본 정밀도로 남으므로, 일반 게임(30일)은 예전 vector와 똑같이 동작합니다.
+// 압축 청크를 푸는 버퍼는 객체마다 하나를 재사용하므로(마지막으로 푼 청크 기억), 같은 객체의 const 조회를
+// 여러 스레드에서 동시에 부르면 안 됩니다. (회사마다 객체가 따로라서 회사별 병렬 처리는 괜찮음)
+
+struct HistoryConfig {
+    int recentDays = 256; //원본 그대로 두는 최근 날 수 (2 이상)
+    int chunkDays = 128; //압축 청크 하나의 날 수
+    int maxChunks = 8; //무손실로 남길 압축 청크 수 (0이면 링에서 밀려난 날은 바로 봉으로)
+    int rollupBars = 128; //그보다 오래된 날을 묶는 봉 수 상한
+
+    bool operator==(const HistoryConfig& o) const {
+        return recentDays == o.recentDays && chunkDays == o.chunkDays && maxChunks == o.maxChunks &&
+               rollupBars == o.rollupBars;
+    }
+};
+
+class PriceHistory {
+public:
+    using Bucket = MinMaxDownsampler::Bucket;
+
+    explicit PriceHistory(const HistoryConfig& config = HistoryConfig());
+
+    const HistoryConfig& config() const { return m_config; }
+    size_t size() const { return m_rollup.count() + m_chunkedDays + m_recent.size(); }
+    bool empty() const { return size() == 0; }
+    //원본 정밀도로 남아 있는 첫 날 (그 앞은 봉으로 묶임)
+    size_t exactBegin() const { return m_rollup.count(); }
+
+    void push(double price);
+    double back() const { return m_recent[(m_recentStart + m_recent.size() - 1) % m_recent.size()]; }
+    //오늘 값 고치기 (거래 체결, 가장 최근 값은 항상 링에 있음)
+    void setBack(double price) { m_recent[(m_recentStart + m_recent.size() - 1) % m_recent.size()] = price; }
+
+    //하루 값: 최근 구간은 O(1), 압축 구간은 청크 하나를 풀고(같은 청크면 다시 풀지 않음), 봉으로 묶인 날은 그 봉의 마지막 값
+    double at(size_t day) const;
+    double operator[](size_t day) const { return at(day); }
+
+    //[begin, end) 구간을 오래된 날부터: 봉으로 묶인 날은 fn(봉, 그 봉에서 구간에 든 날 수),
+    //원본이 있는 날은 fn({v, v, v, v}, 1). 청크는 한 번씩만 풀어서 구간 길이에 비례합니다.
+    template<class Fn> void visit(size_t begin, size_t end, Fn&& fn) const;
+    //[begin, end)를 하루 값으로 out 뒤에 붙임 (봉으로 묶인 날은 봉의 마지막 값)
+    void copy(size_t begin, size_t end, vector<double>& out) const;
+
+    //저장/복원: 봉 구간은 그대로, 원본 구간(exactBegin부터)은 값으로 다시 넣어 같은 상태를 만듦
+    const MinMaxDownsampler& rollup() const { return m_rollup; }
+    bool restore(const Bucket* buckets, size_t bucketCount, size_t span, size_t rolledDays,
+                 const double* exact, size_t exactCount);
+
+    size_t memoryBytes() const; //대략적인 힙 사용량 (청크 비트 포함)
+
+private:
+    //XOR 압축 청크 (비트열은 64비트 워드에 앞에서부터)
+    struct Chunk {
+        vector<uint64_t> words;
+        uint32_t bits = 0;
+        uint32_t count = 0;
+    };
+
+    HistoryConfig m_config;
+    MinMaxDownsampler m_rollup; //가장 오래된 구간 (봉)
+    vector<Chunk> m_chunks; //오래된 것부터, 마지막 청크만 채우는 중일 수 있음
+    size_t m_chunkedDays = 0;
+    uint64_t m_prevBits = 0; //채우는 중인 청크의 인코더 상태
+    int m_lead = -1;
+    int m_trail = 0;
+    mutable vector<double> m_scratch; //청크를 푼 값 (chunkDays개, 조회 사이에 재사용)
+    mutable size_t m_scratchChunk = NoChunk; //m_scratch에 풀려 있는 청크 번호
+    vector<double> m_recent; //링 버퍼 (가득 차면 m_recentStart가 가장 오래된 자리)
+    size_t m_recentStart = 0;
+
+    static constexpr size_t NoChunk = ~size_t(0);
+
+    void spill(double price); //링에서 밀려난 값을 청크로
+    const double* decoded(size_t chunk) const; //청크를 m_scratch에 풀어 둠
+    void encode(Chunk& chunk, double price);
+    void decode(const Chunk& chunk, double* out) const;
+    double recent(size_t i) const { return m_recent[(m_recentStart + i) % m_recent.size()]; }
+};
+
+template<class Fn>
+void PriceHistory::visit(size_t begin, size_t end, Fn&& fn) const {
+    end = min(end, size());
+    if (begin >= end) return;
+    //봉 구간
+    const size_t rolled = m_rollup.count();
+    if (begin < rolled) {
+        const size_t span = m_rollup.span();
+        const auto& buckets = m_rollup.buckets();
+        for (size_t b = begin / span; b < buckets.size() && b * span < min(end, rolled); b++) {
+            const size_t first = max(begin, b * span);
+            const size_t last = min({ end, rolled, (b + 1) * span });
+            fn(buckets[b], last - first);
+        }
+        begin = rolled;
+        if (begin >= end) return;
+    }
+    //압축 구간 (청크마다 한 번 풀기)
+    const size_t chunkDays = (size_t)m_config.chunkDays;
+    if (begin < rolled + m_chunkedDays) {
+        for (size_t c = (begin - rolled) / chunkDays; c < m_chunks.size(); c++) {
+            const size_t base = rolled + c * chunkDays;
+            if (base >= end) return;
+            const double* values = decoded(c);
+            for (size_t i = max(begin, base) - base; i < m_chunks[c].count && base + i < end; i++)
+                fn(Bucket{ values[i], values[i], values[i], values[i] }, 1);
+        }
+        begin = rolled + m_chunkedDays;
+    }
+    //최근 구간
+    const size_t base = rolled + m_chunkedDays;
+    for (size_t d = begin; d < end; d++) {
+        const double v = recent(d - base);
+        fn(Bucket{ v, v, v, v }, 1);
+    }
+}
+
+#endif // PRICEHISTORY_H
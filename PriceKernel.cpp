@@ -0,0 +1,68 @@
+﻿#include "PriceKernel.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#define PRICEKERNEL_X86 1
+#endif
+
+namespace {
+
+void applyScalar(double* basePrice, double* finalPrice,
+                 const double* minor, const double* buff, const double* noise, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        double base = basePrice[i] * minor[i];
+        base *= (1.0 + buff[i]);
+        basePrice[i] = base;
+        finalPrice[i] = base * noise[i];
+    }
+}
+
+#if defined(PRICEKERNEL_X86) && (defined(__GNUC__) || defined(__clang__))
+#define PRICEKERNEL_AVX2_ATTR __attribute__((target("avx2")))
+#define PRICEKERNEL_HAS_AVX2 1
+#elif defined(PRICEKERNEL_X86) && defined(__AVX2__)
+#define PRICEKERNEL_AVX2_ATTR
+#define PRICEKERNEL_HAS_AVX2 1
+#endif
+
+#ifdef PRICEKERNEL_HAS_AVX2
+PRICEKERNEL_AVX2_ATTR
+void applyAvx2(double* basePrice, double* finalPrice,
+               const double* minor, const double* buff, const double* noise, size_t count) {
+    const __m256d one = _mm256_set1_pd(1.0);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d base = _mm256_mul_pd(_mm256_loadu_pd(basePrice + i), _mm256_loadu_pd(minor + i));
+        base = _mm256_mul_pd(base, _mm256_add_pd(one, _mm256_loadu_pd(buff + i)));
+        _mm256_storeu_pd(basePrice + i, base);
+        _mm256_storeu_pd(finalPrice + i, _mm256_mul_pd(base, _mm256_loadu_pd(noise + i)));
+    }
+    applyScalar(basePrice, finalPrice, minor, buff, noise, i, count);
+}
+
+bool cpuHasAvx2() {
+#if defined(__GNUC__) || defined(__clang__)
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has;
+#else
+    return true; // /arch:AVX2로 빌드한 경우에만 이 경로가 컴파일됨
+#endif
+}
+#endif
+
+}
+
+void applyPriceStep(double* basePrice, double* finalPrice,
+                    const double* minor, const double* buff, const double* noise, size_t count) {
+#ifdef PRICEKERNEL_HAS_AVX2
+    if (cpuHasAvx2()) { applyAvx2(basePrice, finalPrice, minor, buff, noise, count); return; }
+#endif
+    applyScalar(basePrice, finalPrice, minor, buff, noise, 0, count);
+}
+
+const char* priceKernelName() {
+#ifdef PRICEKERNEL_HAS_AVX2
+    if (cpuHasAvx2()) return "avx2";
+#endif
+    return "scalar";
+}
@@ -0,0 +1,18 @@
+﻿#ifndef PRICEKERNEL_H
+#define PRICEKERNEL_H
+
+#include <cstddef>
+
+// 하루치 주가 갱신 커널 (회사 전체를 한 번에 처리)
+// 회사별 난수는 미리 뽑아 배열로 넘기고, 커널은 곱셈만 SIMD로 처리합니다.
+//   basePrice *= minor
+//   basePrice *= (1 + buff)
+//   finalPrice = basePrice * noise
+// AVX2를 지원하는 CPU에서는 4개씩, 아니면 스칼라로 계산하며 두 경로의 결과는 비트 단위로 같습니다.
+void applyPriceStep(double* basePrice, double* finalPrice,
+                    const double* minor, const double* buff, const double* noise, size_t count);
+
+// 현재 사용중인 커널 경로 이름 ("avx2" 또는 "scalar")
+const char* priceKernelName();
+
+#endif // PRICEKERNEL_H
@@ -0,0 +1,257 @@
+﻿#include "Profiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+thread_local uint64_t t_allocations = 0;
+
+//트레이스의 tid로 쓸 작은 스레드 번호 (처음 기록할 때 매김)
+atomic<uint32_t> g_nextThread{1};
+thread_local uint32_t t_thread = 0;
+
+uint32_t threadId() {
+    if (t_thread == 0) t_thread = g_nextThread.fetch_add(1, memory_order_relaxed);
+    return t_thread;
+}
+
+atomic<uint64_t> g_nextProfiler{1};
+
+//스레드 버퍼 하나의 트레이스 링 크기 (턴마다 비우므로 턴 하나의 구간만 담으면 됨)
+constexpr size_t ThreadTraceCapacity = 8192;
+
+}
+
+//쓰는 스레드는 하나뿐이고(claimed), 합치는 쪽은 m_mutex를 잡은 스레드 하나뿐
+//통계는 relaxed fetch_add/exchange, 트레이스는 단일 생산자/단일 소비자 링 (가득 차면 버림)
+struct Profiler::ThreadBuffer {
+    explicit ThreadBuffer(size_t traceCapacity) : events(traceCapacity) {
+        for (int p = 0; p < PhaseCount; p++) {
+            calls[p].store(0, memory_order_relaxed);
+            ns[p].store(0, memory_order_relaxed);
+            maxNs[p].store(0, memory_order_relaxed);
+        }
+    }
+
+    atomic<bool> claimed{false}; //살아 있는 스레드가 쓰는 중 (스레드가 끝나면 다른 스레드가 이어 씀)
+    alignas(64) atomic<uint64_t> calls[PhaseCount];
+    atomic<uint64_t> ns[PhaseCount];
+    atomic<uint64_t> maxNs[PhaseCount];
+    vector<TraceEvent> events;
+    atomic<size_t> head{0}; //쓰는 스레드가 올림
+    atomic<size_t> tail{0}; //합치는 쪽이 올림
+
+    void push(const TraceEvent& e) {
+        const size_t h = head.load(memory_order_relaxed);
+        if (events.empty() || h - tail.load(memory_order_acquire) == events.size()) return;
+        events[h % events.size()] = e;
+        head.store(h + 1, memory_order_release);
+    }
+};
+
+//스레드가 끝나면 버퍼를 놓아 줌 (프로파일러가 먼저 사라져도 shared_ptr이라 안전)
+struct Profiler::ThreadCache {
+    vector<pair<uint64_t, shared_ptr<ThreadBuffer>>> entries;
+    ~ThreadCache() {
+        for (auto& e : entries) e.second->claimed.store(false, memory_order_release);
+    }
+};
+
+#ifdef STOCKGAME_PROFILE
+//할당 수를 세기 위해 전역 operator new/delete를 바꿈 (프로파일 빌드에서만)
+void* operator new(size_t size) {
+    t_allocations++;
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+#endif
+
+Profiler::Profiler(size_t traceCapacity)
+    : m_epoch(Clock::now()), m_id(g_nextProfiler.fetch_add(1, memory_order_relaxed)), m_traceCapacity(traceCapacity) {
+    for (auto& c : m_current) c.store(0, memory_order_relaxed);
+}
+
+bool Profiler::compiledIn() {
+#ifdef STOCKGAME_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint64_t Profiler::threadAllocations() {
+    return t_allocations;
+}
+
+const char* Profiler::phaseName(Phase phase) {
+    static const char* names[PhaseCount] = {
+        "nextTurn", "TickCooldowns", "UpdateEffects", "ProcessEvents", "EventScan", "EffectApply", "NewsBuild",
+        "CalculatePrices", "calculateTotalAsset", "stockList"
+    };
+    return phase < PhaseCount ? names[phase] : "?";
+}
+
+const char* Profiler::counterName(Counter counter) {
+    static const char* names[CounterCount] = {
+        "eventsFired", "effectsAdded", "effectsReversed", "effectsErased", "allocations"
+    };
+    return counter < CounterCount ? names[counter] : "?";
+}
+
+Profiler::ThreadBuffer& Profiler::threadBuffer() {
+    static thread_local ThreadCache cache;
+    for (const auto& e : cache.entries) {
+        if (e.first == m_id) return *e.second;
+    }
+    //처음 기록하는 프로파일러: 사라진 프로파일러의 버퍼는 정리하고, 놓인 버퍼가 있으면 이어 씀
+    cache.entries.erase(remove_if(cache.entries.begin(), cache.entries.end(),
+                                  [](const auto& e) { return e.second.use_count() == 1; }),
+                        cache.entries.end());
+    shared_ptr<ThreadBuffer> buffer;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        for (const auto& b : m_buffers) {
+            bool free = false;
+            if (b->claimed.compare_exchange_strong(free, true, memory_order_acquire)) { buffer = b; break; }
+        }
+        if (!buffer) {
+            buffer = make_shared<ThreadBuffer>(min(m_traceCapacity, ThreadTraceCapacity));
+            buffer->claimed.store(true, memory_order_relaxed);
+            m_buffers.push_back(buffer);
+        }
+    }
+    cache.entries.emplace_back(m_id, buffer);
+    return *buffer;
+}
+
+void Profiler::merge() const {
+    for (const auto& b : m_buffers) {
+        for (int p = 0; p < PhaseCount; p++) {
+            const uint64_t calls = b->calls[p].exchange(0, memory_order_relaxed);
+            if (!calls) continue;
+            const uint64_t ns = b->ns[p].exchange(0, memory_order_relaxed);
+            PhaseStats& s = m_phases[p];
+            s.calls += calls;
+            s.totalNs += ns;
+            s.maxNs = max(s.maxNs, b->maxNs[p].exchange(0, memory_order_relaxed));
+            m_turnCalls[p] += calls;
+            m_turnNs[p] += ns;
+        }
+        size_t tail = b->tail.load(memory_order_relaxed);
+        const size_t head = b->head.load(memory_order_acquire);
+        for (; tail != head; tail++) {
+            const TraceEvent& event = b->events[tail % b->events.size()];
+            if (m_trace.size() < m_traceCapacity) m_trace.push_back(event);
+            else m_trace[m_traceNext] = event;
+            m_traceNext = (m_traceNext + 1) % m_traceCapacity;
+        }
+        b->tail.store(tail, memory_order_release);
+    }
+}
+
+void Profiler::record(Phase phase, uint64_t startNs, uint64_t durationNs) {
+    ThreadBuffer& b = threadBuffer();
+    b.calls[phase].fetch_add(1, memory_order_relaxed);
+    b.ns[phase].fetch_add(durationNs, memory_order_relaxed);
+    if (durationNs > b.maxNs[phase].load(memory_order_relaxed)) b.maxNs[phase].store(durationNs, memory_order_relaxed);
+    if (m_traceCapacity > 0) b.push(TraceEvent{ startNs, durationNs, threadId(), (uint8_t)phase });
+
+    if (phase != Turn) return;
+    //턴 마감: 모든 스레드 버퍼를 합치고 이번 턴 값을 lastTurn으로 넘긴 뒤 다음 턴을 위해 비움
+    lock_guard<mutex> lock(m_mutex);
+    merge();
+    m_turns++;
+    for (int p = 0; p < PhaseCount; p++) {
+        m_phases[p].lastTurnCalls = m_turnCalls[p];
+        m_phases[p].lastTurnNs = m_turnNs[p];
+        m_turnCalls[p] = m_turnNs[p] = 0;
+    }
+    CounterSample sample;
+    sample.time = startNs + durationNs;
+    for (int c = 0; c < CounterCount; c++) {
+        m_lastTurn[c] = sample.values[c] = m_current[c].exchange(0, memory_order_relaxed);
+        m_total[c] += m_lastTurn[c];
+    }
+    if (m_traceCapacity > 0) {
+        //카운터 샘플은 턴마다 하나라서 구간보다 훨씬 적게 둠
+        const size_t capacity = max<size_t>(1, m_traceCapacity / 16);
+        if (m_samples.size() < capacity) m_samples.push_back(sample);
+        else m_samples[m_sampleNext] = sample;
+        m_sampleNext = (m_sampleNext + 1) % capacity;
+    }
+}
+
+Profiler::Report Profiler::report() const {
+    Report r;
+    lock_guard<mutex> lock(m_mutex);
+    merge(); //턴 밖에서 기록된 구간(StockList 등)도 보이도록
+    r.turns = m_turns;
+    for (int p = 0; p < PhaseCount; p++) r.phases[p] = m_phases[p];
+    for (int c = 0; c < CounterCount; c++) {
+        r.lastTurn[c] = m_lastTurn[c];
+        r.total[c] = m_total[c];
+    }
+    return r;
+}
+
+void Profiler::reset() {
+    lock_guard<mutex> lock(m_mutex);
+    merge(); //스레드 버퍼에 남은 것도 버림
+    m_turns = 0;
+    for (int p = 0; p < PhaseCount; p++) {
+        m_phases[p] = PhaseStats{};
+        m_turnCalls[p] = m_turnNs[p] = 0;
+    }
+    for (int c = 0; c < CounterCount; c++) {
+        m_current[c].store(0, memory_order_relaxed);
+        m_lastTurn[c] = m_total[c] = 0;
+    }
+    m_trace.clear();
+    m_traceNext = 0;
+    m_samples.clear();
+    m_sampleNext = 0;
+}
+
+//Chrome 트레이스 이벤트 형식: 구간은 "X"(시작 + 길이), 턴 카운터는 "C", 시간 단위는 마이크로초
+bool Profiler::writeChromeTrace(const string& path, string* error) const {
+    FILE* f = fopen(path.c_str(), "w");
+    if (!f) {
+        if (error) *error = "cannot write " + path;
+        return false;
+    }
+    lock_guard<mutex> lock(m_mutex);
+    merge();
+    fprintf(f, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+    fprintf(f, "  {\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 0, \"args\": {\"name\": \"StockGame\"}}");
+    //링 버퍼를 오래된 것부터
+    const size_t traced = m_trace.size();
+    const size_t first = (traced < m_traceCapacity) ? 0 : m_traceNext;
+    for (size_t i = 0; i < traced; i++) {
+        const TraceEvent& e = m_trace[(first + i) % traced];
+        fprintf(f, ",\n  {\"name\": \"%s\", \"cat\": \"turn\", \"ph\": \"X\", \"pid\": 1, \"tid\": %u, "
+                   "\"ts\": %.3f, \"dur\": %.3f}",
+                phaseName((Phase)e.phase), e.thread, e.start / 1000.0, e.duration / 1000.0);
+    }
+    const size_t sampled = m_samples.size();
+    const size_t firstSample = (sampled < max<size_t>(1, m_traceCapacity / 16)) ? 0 : m_sampleNext;
+    for (size_t i = 0; i < sampled; i++) {
+        const CounterSample& s = m_samples[(firstSample + i) % sampled];
+        fprintf(f, ",\n  {\"name\": \"turn counters\", \"ph\": \"C\", \"pid\": 1, \"tid\": 0, \"ts\": %.3f, \"args\": {",
+                s.time / 1000.0);
+        for (int c = 0; c < CounterCount; c++)
+            fprintf(f, "%s\"%s\": %lld", c ? ", " : "", counterName((Counter)c), (long long)s.values[c]);
+        fprintf(f, "}}");
+    }
+    fprintf(f, "\n]}\n");
+    const bool ok = !ferror(f);
+    fclose(f);
+    if (!ok && error) *error = "write failed: " + path;
+    return ok;
+}
@@ -0,0 +1,153 @@
+﻿#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// 턴 단계별 프로파일러
+// 단계 시간은 RAII 스코프(PROFILE_SCOPE)로, 이벤트/이펙트/할당 수는 카운터(PROFILE_COUNT)로 모읍니다.
+// STOCKGAME_PROFILE로 빌드할 때만 매크로가 코드를 만들고, 아니면 통째로 빠져서 비용이 없습니다.
+// 프로파일 빌드에서도 Market에 프로파일러를 붙이지 않으면(nullptr) 포인터 검사 하나만 남습니다.
+// 최근 구간은 링 버퍼에 남겨 두었다가 Chrome 트레이스 JSON(chrome://tracing, Perfetto)으로 내보냅니다.
+// 구간 기록은 스레드마다 자기 버퍼(relaxed 원자 카운터 + 단일 생산자 링)에만 쓰므로 잠금이 없고,
+// 병렬 가격 계산 중에도 워커끼리 서로 기다리지 않습니다. 버퍼는 턴이 끝날 때와 report/덤프 때 합칩니다.
+class Profiler {
+public:
+    enum Phase : uint8_t {
+        Turn, //nextTurn 전체
+        TickCooldowns,
+        UpdateEffects,
+        ProcessEvents,
+        EventScan, //이벤트 하나의 후보 회사 수집
+        EffectApply, //이벤트 하나의 기준가/이펙트 적용
+        NewsBuild, //일반 뉴스 추가와 섞기
+        CalculatePrices,
+        TotalAsset,
+        StockList, //QML에 넘길 종목 목록 만들기
+        PhaseCount
+    };
+    enum Counter : uint8_t {
+        EventsFired,
+        EffectsAdded,
+        EffectsReversed,
+        EffectsErased,
+        Allocations, //턴을 진행한 스레드의 operator new 호출 수
+        CounterCount
+    };
+
+    struct PhaseStats {
+        uint64_t calls = 0;
+        uint64_t totalNs = 0;
+        uint64_t maxNs = 0;
+        uint64_t lastTurnCalls = 0; //직전 턴 (그 전 턴이 끝난 뒤부터의 호출 포함)
+        uint64_t lastTurnNs = 0;
+    };
+    struct Report {
+        uint64_t turns = 0;
+        PhaseStats phases[PhaseCount];
+        int64_t lastTurn[CounterCount] = {};
+        int64_t total[CounterCount] = {};
+    };
+
+    //traceCapacity: 트레이스에 남길 최근 구간 수 (0이면 통계만 모음)
+    explicit Profiler(size_t traceCapacity = 1 << 16);
+
+    static const char* phaseName(Phase phase);
+    static const char* counterName(Counter counter);
+    //STOCKGAME_PROFILE 빌드인지 (아니면 아무것도 기록되지 않음)
+    static bool compiledIn();
+    //현재 스레드의 누적 할당 수 (프로파일 빌드가 아니면 항상 0)
+    static uint64_t threadAllocations();
+
+    uint64_t now() const { return (uint64_t)chrono::duration_cast<chrono::nanoseconds>(Clock::now() - m_epoch).count(); }
+    //Turn 구간이 끝나면 턴 단위 값(lastTurn)을 넘기고 카운터 샘플을 트레이스에 남깁니다.
+    //(잠금 없음, 단 Turn 구간은 끝날 때 모든 스레드 버퍼를 합침)
+    void record(Phase phase, uint64_t startNs, uint64_t durationNs);
+    void count(Counter counter, int64_t n) { m_current[counter].fetch_add(n, memory_order_relaxed); }
+
+    Report report() const;
+    void reset();
+    bool writeChromeTrace(const string& path, string* error = nullptr) const;
+
+    class Scope {
+    public:
+        Scope(Profiler* profiler, Phase phase) : m_profiler(profiler), m_phase(phase) {
+            if (!m_profiler) return;
+            if (m_phase == Turn) m_allocations = threadAllocations();
+            m_start = m_profiler->now();
+        }
+        ~Scope() {
+            if (!m_profiler) return;
+            const uint64_t end = m_profiler->now();
+            if (m_phase == Turn) m_profiler->count(Allocations, (int64_t)(threadAllocations() - m_allocations));
+            m_profiler->record(m_phase, m_start, end - m_start);
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Profiler* m_profiler;
+        Phase m_phase;
+        uint64_t m_start = 0;
+        uint64_t m_allocations = 0;
+    };
+
+private:
+    using Clock = chrono::steady_clock;
+
+    struct TraceEvent {
+        uint64_t start;
+        uint64_t duration;
+        uint32_t thread;
+        uint8_t phase;
+    };
+    struct CounterSample {
+        uint64_t time;
+        int64_t values[CounterCount];
+    };
+
+    struct ThreadBuffer; //스레드 하나가 쓰는 구간 통계와 트레이스 링
+    struct ThreadCache; //스레드별 (프로파일러 → 버퍼) 목록
+
+    Clock::time_point m_epoch;
+    uint64_t m_id; //스레드 캐시의 키 (프로파일러마다 다름, 재사용하지 않음)
+    atomic<int64_t> m_current[CounterCount]; //진행 중인 턴의 카운터
+
+    //아래는 모두 m_mutex로 보호 (report()도 버퍼를 합치므로 mutable)
+    mutable mutex m_mutex;
+    mutable vector<shared_ptr<ThreadBuffer>> m_buffers;
+    uint64_t m_turns = 0;
+    mutable PhaseStats m_phases[PhaseCount];
+    mutable uint64_t m_turnCalls[PhaseCount] = {};
+    mutable uint64_t m_turnNs[PhaseCount] = {};
+    int64_t m_lastTurn[CounterCount] = {};
+    int64_t m_total[CounterCount] = {};
+    size_t m_traceCapacity;
+    mutable vector<TraceEvent> m_trace; //링 버퍼 (m_traceNext가 가장 오래된 자리)
+    mutable size_t m_traceNext = 0;
+    vector<CounterSample> m_samples; //턴마다 하나 (링 버퍼)
+    size_t m_sampleNext = 0;
+
+    ThreadBuffer& threadBuffer();
+    void merge() const; //스레드 버퍼를 모두 비워 위 통계에 더함 (m_mutex를 잡고 호출)
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+
+#ifdef STOCKGAME_PROFILE
+#define PROFILE_SCOPE(profiler, phase) Profiler::Scope PROFILE_CONCAT(profileScope_, __LINE__)((profiler), Profiler::phase)
+#define PROFILE_COUNT(profiler, counter, n) do { if (profiler) (profiler)->count(Profiler::counter, (n)); } while (0)
+#else
+#define PROFILE_SCOPE(profiler, phase) ((void)0)
+#define PROFILE_COUNT(profiler, counter, n) ((void)0)
+#endif
+
+#endif // PROFILER_H
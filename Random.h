@@ -0,0 +1,91 @@
+﻿#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+// 카운터 기반 난수 (Philox4x32-10, Salmon et al. "Parallel Random Numbers: As Easy as 1, 2, 3")
+// 상태를 가진 생성기 대신 (시드, 용도, 날짜, 대상, 순번)을 그대로 암호화해서 난수를 만듭니다.
+// 같은 키에는 항상 같은 값이 나오므로 회사별 계산을 어떤 순서/스레드 수로 돌려도 결과가 같습니다.
+namespace philox {
+
+inline void round(uint32_t ctr[4], const uint32_t key[2]) {
+    const uint64_t p0 = uint64_t(0xD2511F53) * ctr[0];
+    const uint64_t p1 = uint64_t(0xCD9E8D57) * ctr[2];
+    const uint32_t hi0 = uint32_t(p0 >> 32), lo0 = uint32_t(p0);
+    const uint32_t hi1 = uint32_t(p1 >> 32), lo1 = uint32_t(p1);
+    const uint32_t c1 = ctr[1], c3 = ctr[3];
+    ctr[0] = hi1 ^ c1 ^ key[0];
+    ctr[1] = lo1;
+    ctr[2] = hi0 ^ c3 ^ key[1];
+    ctr[3] = lo0;
+}
+
+//ctr(128비트)를 key(64비트)로 섞어 out에 32비트 난수 4개를 씁니다.
+inline void generate(const uint32_t ctr[4], uint64_t seed, uint32_t out[4]) {
+    uint32_t c[4] = { ctr[0], ctr[1], ctr[2], ctr[3] };
+    uint32_t key[2] = { uint32_t(seed), uint32_t(seed >> 32) };
+    for (int r = 0; r < 10; r++) {
+        round(c, key);
+        key[0] += 0x9E3779B9;
+        key[1] += 0xBB67AE85;
+    }
+    out[0] = c[0]; out[1] = c[1]; out[2] = c[2]; out[3] = c[3];
+}
+
+}
+
+// (시드, 용도, 날짜, 대상) 하나에 대응하는 난수열
+// 순번(draw-slot)은 뽑을 때마다 증가하고, 4개 단위로 Philox 블록을 하나씩 만듭니다.
+class RandomStream {
+public:
+    //난수 용도 (같은 날 같은 대상이라도 용도가 다르면 독립된 난수열)
+    enum Domain : uint32_t {
+        Price = 1, //회사별 주가 변동
+        Events = 2, //이벤트별 발생/대상 선택
+        News = 3, //일반 뉴스 선택과 순서 섞기
+        Trader = 4, //시뮬레이션용 자동 매매
+        Liquidity = 5, //주문장의 시장 조성 호가
+        Intraday = 6, //장중 틱 경로
+    };
+
+    RandomStream(uint64_t seed, uint32_t domain, uint32_t day, uint32_t target)
+        : m_seed(seed), m_domain(domain), m_day(day), m_target(target) {}
+
+    uint32_t next() {
+        if (m_used == 4) refill();
+        return m_block[m_used++];
+    }
+
+    //[min, max] 정수 (곱셈-시프트 방식, 편향은 범위/2^32 이하로 무시 가능)
+    int random_num(int min, int max) {
+        if (min > max) { int t = min; min = max; max = t; }
+        uint64_t range = uint64_t(int64_t(max) - int64_t(min)) + 1;
+        return int(int64_t(min) + int64_t((uint64_t(next()) * range) >> 32));
+    }
+
+    bool roll(int chance) { return random_num(1, 100) <= chance; }
+
+    //피셔-예이츠 섞기 (표준 라이브러리 구현 차이 없이 항상 같은 결과)
+    template <typename T>
+    void shuffle(T* data, int count) {
+        for (int i = count - 1; i > 0; i--) {
+            int j = random_num(0, i);
+            T tmp = data[i]; data[i] = data[j]; data[j] = tmp;
+        }
+    }
+
+private:
+    uint64_t m_seed;
+    uint32_t m_domain, m_day, m_target;
+    uint32_t m_slot = 0; //다음에 만들 블록 번호
+    uint32_t m_block[4] = {};
+    int m_used = 4;
+
+    void refill() {
+        const uint32_t ctr[4] = { m_day, m_target, m_slot++, m_domain };
+        philox::generate(ctr, m_seed, m_block);
+        m_used = 0;
+    }
+};
+
+#endif // RANDOM_H
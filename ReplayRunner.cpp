@@ -0,0 +1,161 @@
+﻿// 저널 재생기 (회귀 검사용)
+// 저장된 저널을 처음부터 다시 시뮬레이션해서 매 턴 날짜/총자산이 기록과 비트 단위로 같은지 확인합니다.
+// --resume-check를 주면 중간에 스냅샷으로 저장/복원한 뒤 나머지를 이어서 재생해 이어하기 경로도 검사합니다.
+//
+// 사용법: stockReplay [--scenario file] [--threads T] [--repeat R] [--resume-check] journal...
+//         stockReplay --record N dir [--scenario file] [--seed S]   무작위 거래 저널 N개 생성
+#include "Market.h"
+#include "SaveGame.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+namespace {
+
+struct Options {
+    const char* scenario = nullptr;
+    unsigned threads = thread::hardware_concurrency();
+    int repeat = 1;
+    bool resumeCheck = false;
+    long long record = 0; //0이 아니면 저널 생성 모드
+    const char* recordDir = nullptr;
+    uint64_t seed = 20240601;
+    vector<const char*> journals;
+};
+
+bool parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        const char* v = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!strcmp(a, "--scenario") && v) { opt.scenario = v; i++; }
+        else if (!strcmp(a, "--threads") && v) { opt.threads = (unsigned)atoi(v); i++; }
+        else if (!strcmp(a, "--repeat") && v) { opt.repeat = atoi(v); i++; }
+        else if (!strcmp(a, "--resume-check")) { opt.resumeCheck = true; }
+        else if (!strcmp(a, "--seed") && v) { opt.seed = strtoull(v, nullptr, 10); i++; }
+        else if (!strcmp(a, "--record") && v && i + 2 < argc) { opt.record = atoll(v); opt.recordDir = argv[i + 2]; i += 2; }
+        else if (a[0] == '-') return false;
+        else opt.journals.push_back(a);
+    }
+    if (opt.record) return opt.record > 0;
+    return !opt.journals.empty() && opt.repeat > 0;
+}
+
+//무작위 거래로 한 판을 진행하며 저널에 기록
+//매일 미체결 주문 취소 → 전량 매도 → 한 종목에 현금 30%로 2% 아래 지정가 매수 → 나머지 현금으로 시장가 매수
+bool recordGame(const shared_ptr<const Scenario>& scenario, uint64_t seed, const string& path) {
+    string error;
+    JournalWriter writer;
+    if (!writer.create(path, seed, scenario->fingerprint(), &error)) { fprintf(stderr, "%s\n", error.c_str()); return false; }
+    Market m(scenario, seed);
+    while (true) {
+        m.nextTurn();
+        writer.turn(m);
+        if (m.isOver()) break;
+        for (int i = 0; i < m.companyCount(); i++) {
+            int owned = m.owned(i);
+            if (owned > 0 && m.sellStock(i, owned)) writer.sell(i, owned);
+        }
+        vector<uint32_t> pending;
+        for (const PendingOrder& o : m.pendingOrders()) pending.push_back(o.id);
+        for (uint32_t id : pending) {
+            if (m.cancelOrder(id)) writer.cancel(id);
+        }
+        int pick = RandomStream(seed, RandomStream::Trader, m.day(), 0).random_num(0, m.companyCount() - 1);
+        double limit = floor(m.price(pick) * 0.98);
+        int limitAmount = limit > 0 ? (int)(m.cash() * 0.3 / limit) : 0;
+        if (limitAmount > 0 && m.placeLimitOrder(pick, true, limit, limitAmount)) writer.limit(pick, true, limit, limitAmount);
+        int amount = m.price(pick) > 0 ? (int)(m.cash() / m.price(pick)) : 0;
+        if (amount > 0 && m.buyStock(pick, amount)) writer.buy(pick, amount);
+    }
+    return true;
+}
+
+bool replayOne(const shared_ptr<const Scenario>& scenario, const JournalView& view, bool resumeCheck, string* error) {
+    Market m(scenario, view.header().seed);
+    if (!resumeCheck) return replayJournal(m, view.records(), view.count(), error);
+
+    //앞 절반 재생 → 스냅샷 저장 → 새 시장에 복원 → 나머지 재생
+    const size_t half = view.count() / 2;
+    if (!replayJournal(m, view.records(), half, error)) return false;
+    vector<char> snapshot;
+    m.saveSnapshot(snapshot, half);
+    Market restored(scenario, 0);
+    uint64_t position = 0;
+    if (!restored.loadSnapshot(snapshot.data(), snapshot.size(), error, &position)) return false;
+    if (position != half) { if (error) *error = "snapshot journal position mismatch"; return false; }
+    return replayJournal(restored, view.records() + half, view.count() - half, error);
+}
+
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        fprintf(stderr, "usage: %s [--scenario file] [--threads T] [--repeat R] [--resume-check] journal...\n"
+                        "       %s --record N dir [--scenario file] [--seed S]\n", argv[0], argv[0]);
+        return 1;
+    }
+
+    shared_ptr<const Scenario> scenario = Scenario::builtin();
+    if (opt.scenario) {
+        string error;
+        scenario = Scenario::load(opt.scenario, &error);
+        if (!scenario) { fprintf(stderr, "%s\n", error.c_str()); return 1; }
+    }
+
+    if (opt.record) {
+        for (long long g = 0; g < opt.record; g++) {
+            string path = string(opt.recordDir) + "/game_" + to_string(g) + ".sgjn";
+            if (!recordGame(scenario, opt.seed + (uint64_t)g, path)) return 1;
+        }
+        printf("recorded %lld journals in %s\n", opt.record, opt.recordDir);
+        return 0;
+    }
+
+    //저널은 매핑해서 그대로 재생
+    vector<unique_ptr<JournalView>> views;
+    for (const char* path : opt.journals) {
+        auto view = make_unique<JournalView>();
+        string error;
+        if (!view->open(path, &error)) { fprintf(stderr, "%s\n", error.c_str()); return 1; }
+        if (view->header().scenario != scenario->fingerprint()) {
+            fprintf(stderr, "%s: journal was recorded with a different scenario\n", path);
+            return 1;
+        }
+        views.push_back(move(view));
+    }
+
+    atomic<long long> replays{0}, failures{0};
+    mutex reportMutex;
+    int reported = 0;
+
+    auto start = chrono::steady_clock::now();
+    {
+        ThreadPool pool(opt.threads);
+        pool.parallelFor(0, views.size(), 64, [&](size_t begin, size_t end) {
+            for (int r = 0; r < opt.repeat; r++) {
+                for (size_t j = begin; j < end; j++) {
+                    string error;
+                    bool ok = replayOne(scenario, *views[j], opt.resumeCheck, &error);
+                    replays++;
+                    if (ok) continue;
+                    failures++;
+                    lock_guard<mutex> lock(reportMutex);
+                    if (r == 0 && reported++ < 10) fprintf(stderr, "%s: %s\n", opt.journals[j], error.c_str());
+                }
+            }
+        });
+    }
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    printf("replayed   : %lld (%zu journals x %d, %u threads%s)\n", replays.load(), views.size(), opt.repeat,
+           opt.threads, opt.resumeCheck ? ", resume check" : "");
+    printf("elapsed    : %.3f s (%.0f replays/s)\n", elapsed, replays.load() / elapsed);
+    printf("diverged   : %lld\n", failures.load());
+    return failures.load() == 0 ? 0 : 2;
+}
@@ -0,0 +1,205 @@
+﻿#include "SaveGame.h"
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+FILE* openFile(const string& path, const char* mode) {
+#ifdef _WIN32
+    //경로는 UTF-8
+    wstring wpath(MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0), L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &wpath[0], (int)wpath.size());
+    wstring wmode(mode, mode + strlen(mode));
+    return _wfopen(wpath.c_str(), wmode.c_str());
+#else
+    return fopen(path.c_str(), mode);
+#endif
+}
+
+bool truncateFile(FILE* f, uint64_t size) {
+#ifdef _WIN32
+    return _chsize_s(_fileno(f), (long long)size) == 0;
+#else
+    return ftruncate(fileno(f), (off_t)size) == 0;
+#endif
+}
+
+bool replaceFile(const string& from, const string& to) {
+#ifdef _WIN32
+    auto wide = [](const string& s) {
+        wstring w(MultiByteToWideChar(CP_UTF8, 0, s.c_str(), -1, nullptr, 0), L'\0');
+        MultiByteToWideChar(CP_UTF8, 0, s.c_str(), -1, &w[0], (int)w.size());
+        return w;
+    };
+    return MoveFileExW(wide(from).c_str(), wide(to).c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+}
+
+bool JournalWriter::create(const string& path, uint64_t seed, uint64_t scenario, string* error) {
+    close();
+    m_file = openFile(path, "wb");
+    if (!m_file) { if (error) *error = "cannot create " + path; return false; }
+    journal::Header h{ journal::Magic, journal::Version, seed, scenario, 0 };
+    if (fwrite(&h, sizeof(h), 1, m_file) != 1 || fflush(m_file) != 0) {
+        close();
+        if (error) *error = "cannot write " + path;
+        return false;
+    }
+    m_count = 0;
+    return true;
+}
+
+bool JournalWriter::resume(const string& path, uint64_t records, string* error) {
+    close();
+    m_file = openFile(path, "r+b");
+    if (!m_file) { if (error) *error = "cannot open " + path; return false; }
+    //이어서 쓸 위치 뒤의 기록(잘린 기록 포함)은 버림
+    const uint64_t size = sizeof(journal::Header) + records * sizeof(journal::Record);
+    if (!truncateFile(m_file, size) || fseek(m_file, 0, SEEK_END) != 0) {
+        close();
+        if (error) *error = "cannot truncate " + path;
+        return false;
+    }
+    m_count = records;
+    return true;
+}
+
+void JournalWriter::close() {
+    if (m_file) fclose(m_file);
+    m_file = nullptr;
+    m_count = 0;
+}
+
+void JournalWriter::write(const journal::Record& record) {
+    if (!m_file) return;
+    if (fwrite(&record, sizeof(record), 1, m_file) == 1) m_count++;
+    fflush(m_file);
+}
+
+bool JournalView::open(const string& path, string* error) {
+    m_count = 0;
+    if (!m_file.open(path, error)) return false;
+    if (m_file.size() < sizeof(journal::Header) || header().magic != journal::Magic) {
+        if (error) *error = path + ": not a journal file";
+        m_file.close();
+        return false;
+    }
+    if (header().version != journal::Version) {
+        if (error) *error = path + ": unsupported journal version";
+        m_file.close();
+        return false;
+    }
+    m_count = (m_file.size() - sizeof(journal::Header)) / sizeof(journal::Record);
+    return true;
+}
+
+bool replayJournal(Market& market, const journal::Record* records, size_t count, string* error) {
+    auto fail = [&](size_t i, const string& why) {
+        if (error) *error = "record " + to_string(i) + " (day " + to_string(market.day()) + "): " + why;
+        return false;
+    };
+    for (size_t i = 0; i < count; i++) {
+        const journal::Record& r = records[i];
+        switch (r.type) {
+        case journal::Buy:
+            if (!market.buyStock(r.index, r.amount)) return fail(i, "buy rejected");
+            break;
+        case journal::Sell:
+            if (!market.sellStock(r.index, r.amount)) return fail(i, "sell rejected");
+            break;
+        case journal::LimitBuy:
+        case journal::LimitSell:
+            if (!market.placeLimitOrder(r.index, r.type == journal::LimitBuy, r.asset, r.amount))
+                return fail(i, "limit order rejected");
+            break;
+        case journal::Cancel:
+            if (!market.cancelOrder((uint32_t)r.index)) return fail(i, "cancel rejected");
+            break;
+        case journal::Turn: {
+            if (market.isOver()) return fail(i, "turn after game over");
+            market.nextTurn();
+            //같은 입력이면 비트 단위로 같은 결과가 나와야 함
+            const double asset = market.totalAsset();
+            if (market.day() != r.day || memcmp(&r.asset, &asset, sizeof(double)) != 0) {
+                char msg[128];
+                snprintf(msg, sizeof(msg), "diverged (expected day %d asset %.17g, got day %d asset %.17g)",
+                         r.day, r.asset, market.day(), asset);
+                return fail(i, msg);
+            }
+            break;
+        }
+        default:
+            return fail(i, "unknown record type");
+        }
+    }
+    return true;
+}
+
+bool resumeGame(const shared_ptr<const Scenario>& scenario, const string& snapshotPath, const string& journalPath,
+                Market& out, uint64_t* journalRecords, string* error) {
+    JournalView view;
+    if (!view.open(journalPath, error)) return false;
+    if (view.header().scenario != scenario->fingerprint()) {
+        if (error) *error = journalPath + ": recorded with a different scenario";
+        return false;
+    }
+
+    Market market(scenario, view.header().seed);
+    //스냅샷이 없을 때도 호출한 쪽의 장중 모드/보조 지표 설정으로 재생 (지표는 스냅샷에 없으므로 항상 out 것을 씀)
+    market.setIntraday(out.intraday());
+    market.setIndicators(out.indicators());
+    uint64_t position = 0;
+    vector<char> snapshot;
+    if (readFile(snapshotPath, snapshot)) {
+        string snapshotError;
+        //스냅샷이 저널과 맞지 않으면(다른 게임/손상) 버리고 처음부터 재생
+        if (!market.loadSnapshot(snapshot.data(), snapshot.size(), &snapshotError, &position) ||
+            market.seed() != view.header().seed || position > view.count()) {
+            market = Market(scenario, view.header().seed);
+            market.setIntraday(out.intraday());
+            market.setIndicators(out.indicators());
+            position = 0;
+        }
+    }
+    if (!replayJournal(market, view.records() + position, view.count() - position, error)) return false;
+
+    out = move(market);
+    if (journalRecords) *journalRecords = view.count();
+    return true;
+}
+
+bool writeFileAtomic(const string& path, const vector<char>& data, string* error) {
+    const string temp = path + ".tmp";
+    FILE* f = openFile(temp, "wb");
+    if (!f) { if (error) *error = "cannot create " + temp; return false; }
+    bool ok = fwrite(data.data(), 1, data.size(), f) == data.size();
+    ok = (fclose(f) == 0) && ok;
+    if (!ok || !replaceFile(temp, path)) {
+        remove(temp.c_str());
+        if (error) *error = "cannot write " + path;
+        return false;
+    }
+    return true;
+}
+
+bool readFile(const string& path, vector<char>& out) {
+    FILE* f = openFile(path, "rb");
+    if (!f) return false;
+    out.clear();
+    char buf[65536];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.insert(out.end(), buf, buf + n);
+    fclose(f);
+    return true;
+}
@@ -0,0 +1,103 @@
+﻿#ifndef SAVEGAME_H
+#define SAVEGAME_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+#include "Market.h"
+
+using namespace std;
+
+// 턴 저널: 게임에 들어간 입력(거래, 하루 진행)만 순서대로 덧붙이는 기록
+// 난수는 (시드, 날짜, 대상)으로 정해지므로 시드와 입력 순서만 있으면 게임 전체가 재현됩니다.
+// 스냅샷(Market::saveSnapshot)과 함께 쓰면 이어하기는 "마지막 스냅샷 + 그 뒤 저널"만 다시 적용합니다.
+namespace journal {
+
+constexpr uint32_t Magic = 0x4E4A4753; //"SGJN"
+constexpr uint32_t Version = 2;
+
+struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t seed; //게임 시드 (난수 카운터는 날짜이므로 따로 기록하지 않음)
+    uint64_t scenario; //Scenario::fingerprint()
+    uint64_t reserved;
+};
+
+enum RecordType : uint32_t { Buy = 1, Sell = 2, Turn = 3, LimitBuy = 4, LimitSell = 5, Cancel = 6 };
+
+struct Record {
+    uint32_t type;
+    int32_t index; //Buy/Sell/Limit*: 회사 인덱스, Cancel: 주문 번호
+    int32_t amount; //Buy/Sell/Limit*: 수량
+    int32_t day; //Turn: 진행 후의 날짜
+    double asset; //Turn: 진행 후의 총자산 (다시 적용할 때 어긋났는지 확인용), Limit*: 지정가
+};
+
+static_assert(sizeof(Header) == 32 && sizeof(Record) == 24, "journal layout changed");
+
+}
+
+//저널 파일에 기록을 덧붙임 (기록마다 flush, 비정상 종료 시 마지막 기록이 잘려도 읽을 때 무시됨)
+class JournalWriter {
+public:
+    JournalWriter() = default;
+    ~JournalWriter() { close(); }
+    JournalWriter(const JournalWriter&) = delete;
+    JournalWriter& operator=(const JournalWriter&) = delete;
+
+    //새 저널 (기존 파일은 지움)
+    bool create(const string& path, uint64_t seed, uint64_t scenario, string* error = nullptr);
+    //기존 저널을 records개까지만 남기고 그 뒤에 이어서 기록
+    bool resume(const string& path, uint64_t records, string* error = nullptr);
+    void close();
+    bool isOpen() const { return m_file != nullptr; }
+    uint64_t count() const { return m_count; }
+
+    void buy(int index, int amount) { write({ journal::Buy, index, amount, 0, 0 }); }
+    void sell(int index, int amount) { write({ journal::Sell, index, amount, 0, 0 }); }
+    void turn(const Market& market) { write({ journal::Turn, 0, 0, market.day(), market.totalAsset() }); }
+    void limit(int index, bool buy, double price, int amount) {
+        write({ buy ? journal::LimitBuy : journal::LimitSell, index, amount, 0, price });
+    }
+    void cancel(uint32_t id) { write({ journal::Cancel, (int32_t)id, 0, 0, 0 }); }
+
+private:
+    FILE* m_file = nullptr;
+    uint64_t m_count = 0;
+    void write(const journal::Record& record);
+};
+
+//저널 파일 읽기 (매핑한 그대로, 끝의 잘린 기록은 제외)
+class JournalView {
+public:
+    bool open(const string& path, string* error = nullptr);
+    const journal::Header& header() const { return *reinterpret_cast<const journal::Header*>(m_file.data()); }
+    const journal::Record* records() const {
+        return reinterpret_cast<const journal::Record*>(m_file.data() + sizeof(journal::Header));
+    }
+    size_t count() const { return m_count; }
+
+private:
+    MappedFile m_file;
+    size_t m_count = 0;
+};
+
+//기록을 시장에 순서대로 다시 적용합니다.
+//거래가 거부되거나 Turn 기록의 날짜/총자산이 다르면 어긋난 위치를 error에 남기고 멈춥니다.
+bool replayJournal(Market& market, const journal::Record* records, size_t count, string* error = nullptr);
+
+//저장된 게임 복원: 마지막 스냅샷(없으면 처음 상태)에 그 뒤의 저널 기록을 다시 적용합니다.
+//journalRecords에는 복원된 상태까지 반영된 저널 기록 수가 들어갑니다. (JournalWriter::resume에 넘김)
+//장중 모드 설정은 스냅샷에 있으면 그것을, 없으면 out에 있던 설정을 씁니다.
+//보조 지표 설정은 out에 있던 것을 그대로 이어받습니다.
+bool resumeGame(const shared_ptr<const Scenario>& scenario, const string& snapshotPath, const string& journalPath,
+                Market& out, uint64_t* journalRecords, string* error = nullptr);
+
+//임시 파일에 쓴 뒤 교체 (쓰는 도중 종료되어도 이전 파일은 그대로)
+bool writeFileAtomic(const string& path, const vector<char>& data, string* error = nullptr);
+bool readFile(const string& path, vector<char>& out);
+
+#endif // SAVEGAME_H
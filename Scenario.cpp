@@ -0,0 +1,560 @@
+﻿#include "Scenario.h"
+#include "BitSet.h"
+#include "Json.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+
+using namespace sgsc;
+
+namespace {
+
+uint64_t fnv1a(const char* data, size_t size) {
+    uint64_t h = 1469598103934665603ull;
+    for (size_t i = 0; i < size; i++) { h ^= (unsigned char)data[i]; h *= 1099511628211ull; }
+    return h;
+}
+
+//8바이트 정렬로 구역을 이어 붙이는 바이너리 작성기
+class BlobWriter {
+public:
+    BlobWriter() { m_bytes.resize(sizeof(Header)); } //헤더 자리는 마지막에 채움
+
+    template<class T>
+    Section add(const T* items, size_t count) {
+        align();
+        Section s{ m_bytes.size(), count };
+        const char* p = reinterpret_cast<const char*>(items);
+        m_bytes.insert(m_bytes.end(), p, p + count * sizeof(T));
+        return s;
+    }
+    template<class T>
+    Section add(const vector<T>& items) { return add(items.data(), items.size()); }
+
+    vector<char> finish(Header header) {
+        align();
+        header.fileSize = m_bytes.size();
+        header.contentHash = 0;
+        memcpy(m_bytes.data(), &header, sizeof(header));
+        header.contentHash = fnv1a(m_bytes.data(), m_bytes.size());
+        memcpy(m_bytes.data(), &header, sizeof(header));
+        return move(m_bytes);
+    }
+
+private:
+    vector<char> m_bytes;
+    void align() { m_bytes.resize((m_bytes.size() + 7) & ~size_t(7), 0); }
+};
+
+class StringTable {
+public:
+    StrRef add(const string& s) {
+        StrRef ref{ (uint32_t)m_data.size(), (uint32_t)s.size() };
+        m_data += s;
+        return ref;
+    }
+    const string& data() const { return m_data; }
+
+private:
+    string m_data;
+};
+
+}
+
+vector<char> Scenario::compile(const ScenarioSource& source, vector<string>* warnings) {
+    auto warn = [&](const string& message) { if (warnings) warnings->push_back(message); };
+    StringTable strings;
+    vector<int32_t> ids;
+
+    //이름 → 정수 ID (컴파일할 때 한 번만, 게임 중에는 문자열 비교 없음)
+    unordered_map<string, int> effectIds;
+    vector<EffectRecord> effects;
+    effects.reserve(source.effects.size());
+    for (const auto& effect : source.effects) {
+        if (!effectIds.emplace(effect.name, (int)effects.size()).second)
+            warn("duplicate effect '" + effect.name + "' (events use the first one)");
+        effects.push_back({ strings.add(effect.name), effect.impact, effect.duration });
+    }
+
+    unordered_map<string, int> featureIds;
+    vector<StrRef> features;
+    auto featureId = [&](const string& name) {
+        auto it = featureIds.find(name);
+        if (it != featureIds.end()) return it->second;
+        features.push_back(strings.add(name));
+        return featureIds[name] = (int)features.size() - 1;
+    };
+    //목록 안의 중복은 한 번만 넣음
+    auto pushUnique = [&](uint32_t begin, int id) {
+        if (find(ids.begin() + begin, ids.end(), id) == ids.end()) ids.push_back(id);
+    };
+
+    vector<CompanyRecord> companies;
+    companies.reserve(source.companies.size());
+    for (const auto& company : source.companies) {
+        CompanyRecord r{};
+        r.name = strings.add(company.name);
+        r.description = strings.add(company.description);
+        r.initialPrice = company.initialPrice;
+        r.featureBegin = (uint32_t)ids.size();
+        for (const auto& f : company.features) pushUnique(r.featureBegin, featureId(f));
+        r.featureCount = (uint32_t)ids.size() - r.featureBegin;
+        companies.push_back(r);
+    }
+
+    vector<EventRecord> events;
+    events.reserve(source.events.size());
+    for (const auto& event : source.events) {
+        EventRecord r{};
+        r.name = strings.add(event.name);
+        r.sentence = strings.add(event.sentence);
+        r.impact = event.impact;
+        r.chance = event.chance;
+        r.cooltime = event.cooltime;
+        r.startCooltime = event.current_cooltime;
+        r.single = event.single;
+        r.stackable = event.stackable;
+        r.hasCompany = event.sentence.find("<company>") != string::npos;
+        r.targetBegin = (uint32_t)ids.size();
+        for (const auto& t : event.target) {
+            if (!featureIds.count(t)) warn("event '" + event.name + "': no company has feature '" + t + "'");
+            pushUnique(r.targetBegin, featureId(t));
+        }
+        r.targetCount = (uint32_t)ids.size() - r.targetBegin;
+        r.effectBegin = (uint32_t)ids.size();
+        for (const auto& name : event.effect) {
+            auto it = effectIds.find(name);
+            if (it != effectIds.end()) ids.push_back(it->second);
+            else warn("event '" + event.name + "': unknown effect '" + name + "' (ignored)");
+        }
+        r.effectCount = (uint32_t)ids.size() - r.effectBegin;
+        events.push_back(r);
+    }
+
+    vector<StrRef> news;
+    news.reserve(source.news.size());
+    for (const auto& line : source.news) news.push_back(strings.add(line));
+
+    //이벤트 타겟 판정용 인덱스 (비트셋은 words 간격으로 평탄하게 저장)
+    const uint32_t featureWords = max(1, bits::wordsFor((int)features.size()));
+    const uint32_t effectWords = max(1, bits::wordsFor((int)effects.size()));
+
+    vector<uint64_t> companyFeatureBits(companies.size() * featureWords, 0);
+    vector<uint32_t> postingOffsets(features.size() + 1, 0);
+    for (size_t c = 0; c < companies.size(); c++) {
+        for (uint32_t i = 0; i < companies[c].featureCount; i++) {
+            int f = ids[companies[c].featureBegin + i];
+            bits::set(&companyFeatureBits[c * featureWords], f);
+            postingOffsets[f + 1]++;
+        }
+    }
+    for (size_t f = 0; f < features.size(); f++) postingOffsets[f + 1] += postingOffsets[f];
+    //회사 순서대로 채우므로 특징별 목록은 자동으로 오름차순
+    vector<int32_t> postings(postingOffsets.back());
+    vector<uint32_t> fill(postingOffsets.begin(), postingOffsets.end() - 1);
+    for (size_t c = 0; c < companies.size(); c++) {
+        for (uint32_t i = 0; i < companies[c].featureCount; i++)
+            postings[fill[ids[companies[c].featureBegin + i]]++] = (int32_t)c;
+    }
+
+    vector<uint64_t> eventTargetBits(events.size() * featureWords, 0);
+    vector<uint64_t> eventEffectBits(events.size() * effectWords, 0);
+    for (size_t e = 0; e < events.size(); e++) {
+        for (uint32_t i = 0; i < events[e].targetCount; i++)
+            bits::set(&eventTargetBits[e * featureWords], ids[events[e].targetBegin + i]);
+        for (uint32_t i = 0; i < events[e].effectCount; i++)
+            bits::set(&eventEffectBits[e * effectWords], ids[events[e].effectBegin + i]);
+    }
+
+    Header h{};
+    h.magic = Magic;
+    h.version = Version;
+    h.startCash = source.startCash;
+    h.goal = source.goal;
+    h.lastDay = source.lastDay;
+    h.featureWords = featureWords;
+    h.effectWords = effectWords;
+
+    BlobWriter w;
+    h.strings = w.add(strings.data().data(), strings.data().size());
+    h.companies = w.add(companies);
+    h.effects = w.add(effects);
+    h.events = w.add(events);
+    h.news = w.add(news);
+    h.features = w.add(features);
+    h.ids = w.add(ids);
+    h.companyFeatureBits = w.add(companyFeatureBits);
+    h.eventTargetBits = w.add(eventTargetBits);
+    h.eventEffectBits = w.add(eventEffectBits);
+    h.postingOffsets = w.add(postingOffsets);
+    h.postings = w.add(postings);
+    return w.finish(h);
+}
+
+bool Scenario::attach(const char* data, size_t size, string* error) {
+    auto fail = [&](const char* why) { if (error) *error = why; return false; };
+    if (size < sizeof(Header)) return fail("file too small for a scenario header");
+    if (reinterpret_cast<uintptr_t>(data) % 8 != 0) return fail("misaligned scenario buffer");
+
+    const Header* h = reinterpret_cast<const Header*>(data);
+    if (h->magic != Magic) return fail("not a compiled scenario (bad magic)");
+    if (h->version != Version) return fail("unsupported scenario version");
+    if (h->fileSize != size) return fail("scenario size mismatch (truncated file?)");
+
+    //구역이 파일 안에 있고 정렬되어 있는지 확인하고 포인터를 잡음
+    bool ok = true;
+    auto section = [&](const Section& s, auto*& out) {
+        const uint64_t elem = sizeof(*out);
+        if (s.offset % 8 != 0 || s.offset > size || s.count > (size - s.offset) / elem || s.count > (uint64_t)INT_MAX)
+            ok = false;
+        else
+            out = reinterpret_cast<remove_reference_t<decltype(out)>>(data + s.offset);
+    };
+    section(h->strings, m_strings);
+    section(h->companies, m_companies);
+    section(h->effects, m_effects);
+    section(h->events, m_events);
+    section(h->news, m_news);
+    section(h->features, m_features);
+    section(h->ids, m_ids);
+    section(h->companyFeatureBits, m_companyFeatureBits);
+    section(h->eventTargetBits, m_eventTargetBits);
+    section(h->eventEffectBits, m_eventEffectBits);
+    section(h->postingOffsets, m_postingOffsets);
+    section(h->postings, m_postings);
+    if (!ok) return fail("scenario section out of bounds");
+
+    const uint64_t companies = h->companies.count, events = h->events.count;
+    const uint64_t features = h->features.count, effects = h->effects.count;
+    if (h->featureWords < (uint32_t)max(1, bits::wordsFor((int)features)) ||
+        h->effectWords < (uint32_t)max(1, bits::wordsFor((int)effects)) ||
+        h->companyFeatureBits.count != companies * h->featureWords ||
+        h->eventTargetBits.count != events * h->featureWords ||
+        h->eventEffectBits.count != events * h->effectWords ||
+        h->postingOffsets.count != features + 1)
+        return fail("scenario index sizes do not match record counts");
+
+    //레코드가 가리키는 문자열/ID 목록이 범위 안인지 (게임 중에는 다시 검사하지 않음)
+    auto strOk = [&](StrRef r) { return (uint64_t)r.offset + r.length <= h->strings.count; };
+    auto listOk = [&](uint32_t begin, uint32_t count, uint64_t limit) {
+        if ((uint64_t)begin + count > h->ids.count) return false;
+        for (uint32_t i = 0; i < count; i++) {
+            if (m_ids[begin + i] < 0 || (uint64_t)m_ids[begin + i] >= limit) return false;
+        }
+        return true;
+    };
+    for (uint64_t c = 0; c < companies; c++) {
+        const CompanyRecord& r = m_companies[c];
+        if (!strOk(r.name) || !strOk(r.description) || !listOk(r.featureBegin, r.featureCount, features))
+            return fail("company record out of range");
+    }
+    for (uint64_t e = 0; e < effects; e++) {
+        if (!strOk(m_effects[e].name)) return fail("effect record out of range");
+    }
+    for (uint64_t e = 0; e < events; e++) {
+        const EventRecord& r = m_events[e];
+        if (!strOk(r.name) || !strOk(r.sentence) || !listOk(r.targetBegin, r.targetCount, features) ||
+            !listOk(r.effectBegin, r.effectCount, effects))
+            return fail("event record out of range");
+    }
+    for (uint64_t n = 0; n < h->news.count; n++) {
+        if (!strOk(m_news[n])) return fail("news record out of range");
+    }
+    for (uint64_t f = 0; f < features; f++) {
+        if (!strOk(m_features[f]) || m_postingOffsets[f] > m_postingOffsets[f + 1]) return fail("feature record out of range");
+    }
+    if (m_postingOffsets[features] != h->postings.count) return fail("feature postings out of range");
+    for (uint64_t p = 0; p < h->postings.count; p++) {
+        if (m_postings[p] < 0 || (uint64_t)m_postings[p] >= companies) return fail("feature postings out of range");
+    }
+
+    //뉴스 문장을 회사 이름 자리 앞/뒤로 나눠 둠 (게임 중에는 찾기/바꾸기 없이 이어 붙이기만 함)
+    static constexpr string_view Slot = "<company>";
+    m_templates.resize(events);
+    for (uint64_t e = 0; e < events; e++) {
+        const StrRef sentence = m_events[e].sentence;
+        const size_t pos = string_view(m_strings + sentence.offset, sentence.length).find(Slot);
+        NewsTemplate& t = m_templates[e];
+        t.hasSlot = pos != string_view::npos;
+        if (!t.hasSlot) {
+            t.head = sentence;
+            t.tail = { sentence.offset + sentence.length, 0 };
+        } else {
+            t.head = { sentence.offset, (uint32_t)pos };
+            t.tail = { sentence.offset + (uint32_t)(pos + Slot.size()), sentence.length - (uint32_t)(pos + Slot.size()) };
+        }
+    }
+
+    m_data = data;
+    m_size = size;
+    m_header = h;
+    return true;
+}
+
+shared_ptr<const Scenario> Scenario::fromBlob(const vector<char>& blob, string* error) {
+    shared_ptr<Scenario> scenario(new Scenario);
+    scenario->m_owned.resize((blob.size() + 7) / 8);
+    memcpy(scenario->m_owned.data(), blob.data(), blob.size());
+    if (!scenario->attach(reinterpret_cast<const char*>(scenario->m_owned.data()), blob.size(), error)) return nullptr;
+    return scenario;
+}
+
+shared_ptr<const Scenario> Scenario::fromSource(const ScenarioSource& source) {
+    return fromBlob(compile(source), nullptr);
+}
+
+shared_ptr<const Scenario> Scenario::load(const string& path, string* error) {
+    shared_ptr<Scenario> scenario(new Scenario);
+    if (!scenario->m_file.open(path, error)) return nullptr;
+    const char* data = scenario->m_file.data();
+    const size_t size = scenario->m_file.size();
+
+    uint32_t magic = 0;
+    if (size >= sizeof(magic)) memcpy(&magic, data, sizeof(magic));
+    if (magic == Magic) {
+        if (!scenario->attach(data, size, error)) {
+            if (error) *error = path + ": " + *error;
+            return nullptr;
+        }
+        return scenario;
+    }
+
+    //컴파일되지 않은 JSON 작성 파일 (개발 중): 읽어서 메모리에서 컴파일
+    ScenarioSource source;
+    if (!scenarioFromJson(string_view(data, size), source, error)) {
+        if (error) *error = path + ":" + *error;
+        return nullptr;
+    }
+    return fromSource(source);
+}
+
+shared_ptr<const Scenario> Scenario::builtin() {
+    static const shared_ptr<const Scenario> scenario = fromSource(defaultScenarioSource());
+    return scenario;
+}
+
+// ---- JSON 작성 파일 ----
+
+namespace {
+
+constexpr int JsonVersion = 1; //작성 파일 형식 버전 (바이너리 형식 버전과 별개)
+
+class JsonReader {
+public:
+    explicit JsonReader(string* error) : m_error(error) {}
+
+    bool fail(const string& where, const string& what) {
+        if (m_error) *m_error = " " + where + ": " + what;
+        return false;
+    }
+
+    const JsonValue* field(const JsonValue& obj, const char* key, JsonValue::Type type, const string& where, bool required) {
+        const JsonValue* v = obj.find(key);
+        if (!v) {
+            if (required) fail(where, string("missing \"") + key + "\"");
+            return nullptr;
+        }
+        if (v->type != type) { fail(where, string("\"") + key + "\" has the wrong type"); return nullptr; }
+        return v;
+    }
+
+    bool str(const JsonValue& obj, const char* key, string& out, const string& where) {
+        const JsonValue* v = field(obj, key, JsonValue::String, where, true);
+        if (!v) return false;
+        out = v->text;
+        return true;
+    }
+
+    bool number(const JsonValue& obj, const char* key, double& out, const string& where, bool required = true) {
+        if (!obj.find(key) && !required) return true;
+        const JsonValue* v = field(obj, key, JsonValue::Number, where, required);
+        if (!v) return false;
+        out = v->number;
+        return true;
+    }
+
+    bool integer(const JsonValue& obj, const char* key, int& out, const string& where, bool required = true) {
+        double d = out;
+        if (!number(obj, key, d, where, required)) return false;
+        //범위 밖/NaN/inf를 int로 바꾸면 정의되지 않은 동작이므로 먼저 걸러냄
+        if (!isfinite(d) || d < INT_MIN || d > INT_MAX || d != (double)(int)d)
+            return fail(where, string("\"") + key + "\" must be an integer");
+        out = (int)d;
+        return true;
+    }
+
+    bool boolean(const JsonValue& obj, const char* key, bool& out, const string& where) {
+        if (!obj.find(key)) return true;
+        const JsonValue* v = field(obj, key, JsonValue::Bool, where, false);
+        if (!v) return false;
+        out = v->boolean;
+        return true;
+    }
+
+    bool strings(const JsonValue& obj, const char* key, vector<string>& out, const string& where) {
+        if (!obj.find(key)) return true;
+        const JsonValue* v = field(obj, key, JsonValue::Array, where, false);
+        if (!v) return false;
+        for (const auto& item : v->items) {
+            if (item.type != JsonValue::String) return fail(where, string("\"") + key + "\" must contain strings");
+            out.push_back(item.text);
+        }
+        return true;
+    }
+
+    const JsonValue* objects(const JsonValue& root, const char* key) {
+        const JsonValue* v = field(root, key, JsonValue::Array, "scenario", true);
+        if (!v) return nullptr;
+        for (const auto& item : v->items) {
+            if (item.type != JsonValue::Object) { fail(key, "entries must be objects"); return nullptr; }
+        }
+        return v;
+    }
+
+private:
+    string* m_error;
+};
+
+void appendNumber(string& out, double v) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.17g", v);
+    //짧게 쓸 수 있으면 짧게 (98000 → "98000")
+    char shortBuf[32];
+    snprintf(shortBuf, sizeof(shortBuf), "%.15g", v);
+    out += (strtod(shortBuf, nullptr) == v) ? shortBuf : buf;
+}
+
+void appendStrings(string& out, const vector<string>& list) {
+    out += '[';
+    for (size_t i = 0; i < list.size(); i++) {
+        if (i) out += ", ";
+        appendJsonString(out, list[i]);
+    }
+    out += ']';
+}
+
+}
+
+bool scenarioFromJson(string_view text, ScenarioSource& out, string* error) {
+    JsonValue root;
+    if (!parseJson(text, root, error)) return false;
+    JsonReader r(error);
+    if (root.type != JsonValue::Object) return r.fail("scenario", "top level must be an object");
+
+    int version = JsonVersion;
+    if (!r.integer(root, "version", version, "scenario", false)) return false;
+    if (version != JsonVersion) return r.fail("scenario", "unsupported \"version\"");
+
+    out = ScenarioSource();
+    if (const JsonValue* rules = root.find("rules")) {
+        if (rules->type != JsonValue::Object) return r.fail("rules", "must be an object");
+        if (!r.number(*rules, "startCash", out.startCash, "rules", false) ||
+            !r.number(*rules, "goal", out.goal, "rules", false) ||
+            !r.integer(*rules, "lastDay", out.lastDay, "rules", false))
+            return false;
+    }
+
+    const JsonValue* companies = r.objects(root, "companies");
+    const JsonValue* effects = companies ? r.objects(root, "effects") : nullptr;
+    const JsonValue* events = effects ? r.objects(root, "events") : nullptr;
+    if (!events) return false;
+
+    for (size_t i = 0; i < companies->items.size(); i++) {
+        const JsonValue& o = companies->items[i];
+        string where = "companies[" + to_string(i) + "]";
+        CompanyInfo c{};
+        if (!r.str(o, "name", c.name, where) || !r.number(o, "price", c.initialPrice, where) ||
+            !r.strings(o, "features", c.features, where))
+            return false;
+        if (o.find("description") && !r.str(o, "description", c.description, where)) return false;
+        if (!(c.initialPrice > 0)) return r.fail(where, "\"price\" must be positive");
+        out.companies.push_back(move(c));
+    }
+
+    for (size_t i = 0; i < effects->items.size(); i++) {
+        const JsonValue& o = effects->items[i];
+        string where = "effects[" + to_string(i) + "]";
+        Effect e{};
+        if (!r.str(o, "name", e.name, where) || !r.integer(o, "impact", e.impact, where) ||
+            !r.integer(o, "duration", e.duration, where))
+            return false;
+        out.effects.push_back(move(e));
+    }
+
+    for (size_t i = 0; i < events->items.size(); i++) {
+        const JsonValue& o = events->items[i];
+        string where = "events[" + to_string(i) + "]";
+        Event e{};
+        if (!r.str(o, "name", e.name, where) || !r.boolean(o, "single", e.single, where) ||
+            !r.boolean(o, "stackable", e.stackable, where) || !r.integer(o, "impact", e.impact, where) ||
+            !r.strings(o, "target", e.target, where) || !r.strings(o, "effects", e.effect, where) ||
+            !r.integer(o, "cooltime", e.cooltime, where) ||
+            !r.integer(o, "startCooltime", e.current_cooltime, where, false) ||
+            !r.str(o, "sentence", e.sentence, where) || !r.integer(o, "chance", e.chance, where))
+            return false;
+        if (e.chance < 0 || e.chance > 100) return r.fail(where, "\"chance\" must be 0-100");
+        out.events.push_back(move(e));
+    }
+
+    if (!r.strings(root, "news", out.news, "scenario")) return false;
+    return true;
+}
+
+string scenarioToJson(const ScenarioSource& source) {
+    string out = "{\n  \"version\": " + to_string(JsonVersion) + ",\n  \"rules\": {\"startCash\": ";
+    appendNumber(out, source.startCash);
+    out += ", \"goal\": ";
+    appendNumber(out, source.goal);
+    out += ", \"lastDay\": " + to_string(source.lastDay) + "},\n";
+
+    out += "  \"companies\": [\n";
+    for (size_t i = 0; i < source.companies.size(); i++) {
+        const CompanyInfo& c = source.companies[i];
+        out += "    {\"name\": ";
+        appendJsonString(out, c.name);
+        out += ", \"price\": ";
+        appendNumber(out, c.initialPrice);
+        out += ", \"features\": ";
+        appendStrings(out, c.features);
+        out += ",\n     \"description\": ";
+        appendJsonString(out, c.description);
+        out += (i + 1 < source.companies.size()) ? "},\n" : "}\n";
+    }
+    out += "  ],\n  \"effects\": [\n";
+    for (size_t i = 0; i < source.effects.size(); i++) {
+        const Effect& e = source.effects[i];
+        out += "    {\"name\": ";
+        appendJsonString(out, e.name);
+        out += ", \"impact\": " + to_string(e.impact) + ", \"duration\": " + to_string(e.duration);
+        out += (i + 1 < source.effects.size()) ? "},\n" : "}\n";
+    }
+    out += "  ],\n  \"events\": [\n";
+    for (size_t i = 0; i < source.events.size(); i++) {
+        const Event& e = source.events[i];
+        out += "    {\"name\": ";
+        appendJsonString(out, e.name);
+        out += string(", \"single\": ") + (e.single ? "true" : "false");
+        out += string(", \"stackable\": ") + (e.stackable ? "true" : "false");
+        out += ", \"impact\": " + to_string(e.impact) + ", \"chance\": " + to_string(e.chance);
+        out += ", \"cooltime\": " + to_string(e.cooltime);
+        if (e.current_cooltime) out += ", \"startCooltime\": " + to_string(e.current_cooltime);
+        out += ",\n     \"target\": ";
+        appendStrings(out, e.target);
+        out += ", \"effects\": ";
+        appendStrings(out, e.effect);
+        out += ",\n     \"sentence\": ";
+        appendJsonString(out, e.sentence);
+        out += (i + 1 < source.events.size()) ? "},\n" : "}\n";
+    }
+    out += "  ],\n  \"news\": [\n";
+    for (size_t i = 0; i < source.news.size(); i++) {
+        out += "    ";
+        appendJsonString(out, source.news[i]);
+        out += (i + 1 < source.news.size()) ? ",\n" : "\n";
+    }
+    out += "  ]\n}\n";
+    return out;
+}
@@ -0,0 +1,237 @@
+﻿#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "MappedFile.h"
+
+using namespace std;
+
+// ---- 작성용 데이터 (JSON/코드에서 채우고 컴파일하면 버림, 게임 중에는 쓰지 않음) ----
+
+struct Effect {
+    string name; //영향 이름
+    int impact; //주가에 미치는 영향
+    int duration; //기본 지속시간
+};
+
+struct CompanyInfo {
+    string name; //회사 이름
+    double initialPrice; //시작 주가
+    vector<string> features; //회사의 특징
+    string description; //회사 정보 설명
+};
+
+struct Event {
+    string name; //이벤트 이름
+    bool single; //이벤트 대상이 하나인지 체크
+    bool stackable; //이벤트 효과가 같은 회사에 중첩 가능한지 체크
+    int impact; //주가에 미치는 영향
+    vector<string> target; //이벤트 영향을 받는 회사의 특징
+    vector<string> effect; //어떤 버프/디버프를 부여하는지 (이펙트 이름)
+    int cooltime; //이벤트 쿨타임(일수)
+    int current_cooltime; //시작 시 남은 쿨타임(일수)
+    string sentence; //뉴스 내용
+    int chance; //이벤트 발생 확률
+};
+
+struct ScenarioSource {
+    double startCash = 1200000; //시작 자금
+    double goal = 4000000; //목표 자산
+    int lastDay = 30; //마지막 날
+    vector<CompanyInfo> companies;
+    vector<Effect> effects;
+    vector<Event> events;
+    vector<string> news;
+};
+
+//코드에 내장된 기본 시나리오 (scenarios/default.json과 같은 내용)
+ScenarioSource defaultScenarioSource();
+
+//JSON 작성 파일 ↔ 작성용 데이터
+bool scenarioFromJson(string_view text, ScenarioSource& out, string* error = nullptr);
+string scenarioToJson(const ScenarioSource& source);
+
+// ---- 컴파일된 바이너리 형식 (.sgsc) ----
+// 헤더 + 문자열 테이블 + 고정 크기 레코드 + 미리 계산한 인덱스(특징/이펙트 비트셋, 역색인)
+// 모든 구역은 8바이트 정렬이고 파일 시작 기준 오프셋으로 가리키므로 매핑한 그대로 읽습니다.
+// 바이트 순서는 리틀 엔디언 고정 (다른 순서의 호스트에서는 매직 검사에서 거부됨)
+namespace sgsc {
+
+constexpr uint32_t Magic = 0x43534753; //"SGSC"
+constexpr uint32_t Version = 2;
+
+struct StrRef {
+    uint32_t offset; //문자열 테이블 안의 위치
+    uint32_t length; //바이트 수 (UTF-8)
+};
+
+struct Section {
+    uint64_t offset; //파일 시작 기준 바이트 위치
+    uint64_t count; //원소 수
+};
+
+struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t fileSize;
+    uint64_t contentHash; //이 필드를 0으로 두고 계산한 전체 바이트의 FNV-1a (세이브/저널이 같은 시나리오인지 확인)
+    double startCash;
+    double goal;
+    int32_t lastDay;
+    uint32_t featureWords; //특징 비트셋 하나의 워드 수
+    uint32_t effectWords; //이펙트 비트셋 하나의 워드 수
+    uint32_t reserved;
+    Section strings; //char
+    Section companies; //CompanyRecord
+    Section effects; //EffectRecord
+    Section events; //EventRecord
+    Section news; //StrRef
+    Section features; //StrRef (특징 ID → 이름)
+    Section ids; //int32 (회사 특징/이벤트 타겟/이벤트 이펙트 목록이 모두 이 풀을 가리킴)
+    Section companyFeatureBits; //uint64, 회사 수 × featureWords
+    Section eventTargetBits; //uint64, 이벤트 수 × featureWords
+    Section eventEffectBits; //uint64, 이벤트 수 × effectWords
+    Section postingOffsets; //uint32, 특징 수 + 1 (특징 f의 회사 목록은 postings[off[f], off[f+1]))
+    Section postings; //int32, 특징 → 해당 특징을 가진 회사 (오름차순)
+};
+
+struct CompanyRecord {
+    StrRef name;
+    StrRef description;
+    double initialPrice;
+    uint32_t featureBegin; //ids 안의 위치
+    uint32_t featureCount;
+};
+
+struct EffectRecord {
+    StrRef name;
+    int32_t impact;
+    int32_t duration;
+};
+
+struct EventRecord {
+    StrRef name;
+    StrRef sentence;
+    int32_t impact;
+    int32_t chance;
+    int32_t cooltime;
+    int32_t startCooltime;
+    uint32_t targetBegin, targetCount; //ids 안의 특징 ID
+    uint32_t effectBegin, effectCount; //ids 안의 이펙트 ID
+    uint8_t single;
+    uint8_t stackable;
+    uint8_t hasCompany; //sentence에 <company>가 들어있는지
+    uint8_t reserved[5];
+};
+
+static_assert(sizeof(Header) == 248, "sgsc header layout changed");
+static_assert(sizeof(CompanyRecord) == 32 && sizeof(EffectRecord) == 16 && sizeof(EventRecord) == 56,
+              "sgsc record layout changed");
+static_assert(is_trivially_copyable<Header>::value && is_trivially_copyable<EventRecord>::value, "");
+
+}
+
+//ID 목록 보기 (복사 없이 바이너리 안을 가리킴)
+struct IdSpan {
+    const int32_t* first = nullptr;
+    const int32_t* last = nullptr;
+    const int32_t* begin() const { return first; }
+    const int32_t* end() const { return last; }
+    size_t size() const { return size_t(last - first); }
+    bool empty() const { return first == last; }
+};
+
+//이벤트 뉴스 문장을 <company> 앞/뒤 조각으로 미리 나눈 것 (로드할 때 한 번만 찾음)
+struct NewsTemplate {
+    sgsc::StrRef head;
+    sgsc::StrRef tail;
+    bool hasSlot; //<company> 자리가 있는지 (없으면 head가 문장 전체)
+};
+
+// 읽기 전용 시나리오 데이터
+// 컴파일된 바이너리를 파일 매핑 또는 메모리 버퍼 위에서 그대로 읽습니다. (필드별 할당/파싱 없음)
+// 한 번 만들면 바뀌지 않으므로 여러 Market(게임)이 shared_ptr로 함께 씁니다.
+class Scenario {
+public:
+    //작성용 데이터를 바이너리로 컴파일 (없는 이펙트 이름 등은 warnings에 남기고 건너뜀)
+    static vector<char> compile(const ScenarioSource& source, vector<string>* warnings = nullptr);
+    //작성용 데이터를 메모리에서 바로 컴파일해서 사용
+    static shared_ptr<const Scenario> fromSource(const ScenarioSource& source);
+    //.sgsc면 매핑해서 바로 사용하고, 그 밖의 파일은 JSON으로 읽어 메모리에서 컴파일합니다.
+    static shared_ptr<const Scenario> load(const string& path, string* error = nullptr);
+    //기본 시나리오 (처음 한 번만 컴파일하고 공유)
+    static shared_ptr<const Scenario> builtin();
+
+    Scenario(const Scenario&) = delete;
+    Scenario& operator=(const Scenario&) = delete;
+
+    double startCash() const { return m_header->startCash; }
+    double goal() const { return m_header->goal; }
+    int lastDay() const { return m_header->lastDay; }
+
+    int companyCount() const { return (int)m_header->companies.count; }
+    int effectCount() const { return (int)m_header->effects.count; }
+    int eventCount() const { return (int)m_header->events.count; }
+    int featureCount() const { return (int)m_header->features.count; }
+    int newsCount() const { return (int)m_header->news.count; }
+
+    const sgsc::CompanyRecord& company(int i) const { return m_companies[i]; }
+    const sgsc::EffectRecord& effect(int i) const { return m_effects[i]; }
+    const sgsc::EventRecord& event(int i) const { return m_events[i]; }
+    string_view text(sgsc::StrRef ref) const { return string_view(m_strings + ref.offset, ref.length); }
+    string_view news(int i) const { return text(m_news[i]); }
+    string_view featureName(int f) const { return text(m_features[f]); }
+    const NewsTemplate& newsTemplate(int e) const { return m_templates[e]; }
+
+    IdSpan companyFeatures(int c) const { return ids(m_companies[c].featureBegin, m_companies[c].featureCount); }
+    IdSpan eventTargets(int e) const { return ids(m_events[e].targetBegin, m_events[e].targetCount); }
+    IdSpan eventEffects(int e) const { return ids(m_events[e].effectBegin, m_events[e].effectCount); }
+    IdSpan featurePostings(int f) const {
+        return { m_postings + m_postingOffsets[f], m_postings + m_postingOffsets[f + 1] };
+    }
+
+    int featureWords() const { return (int)m_header->featureWords; }
+    int effectWords() const { return (int)m_header->effectWords; }
+    const uint64_t* companyFeatureBits(int c) const { return m_companyFeatureBits + (size_t)c * featureWords(); }
+    const uint64_t* eventTargetBits(int e) const { return m_eventTargetBits + (size_t)e * featureWords(); }
+    const uint64_t* eventEffectBits(int e) const { return m_eventEffectBits + (size_t)e * effectWords(); }
+
+    uint64_t fingerprint() const { return m_header->contentHash; }
+    size_t byteSize() const { return m_size; }
+    bool isMapped() const { return m_file.isOpen(); }
+
+private:
+    Scenario() = default;
+
+    vector<uint64_t> m_owned; //메모리에서 컴파일한 경우의 버퍼 (8바이트 정렬 보장)
+    MappedFile m_file; //파일에서 읽은 경우의 매핑
+
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+    const sgsc::Header* m_header = nullptr;
+    const char* m_strings = nullptr;
+    const sgsc::CompanyRecord* m_companies = nullptr;
+    const sgsc::EffectRecord* m_effects = nullptr;
+    const sgsc::EventRecord* m_events = nullptr;
+    const sgsc::StrRef* m_news = nullptr;
+    const sgsc::StrRef* m_features = nullptr;
+    const int32_t* m_ids = nullptr;
+    const uint64_t* m_companyFeatureBits = nullptr;
+    const uint64_t* m_eventTargetBits = nullptr;
+    const uint64_t* m_eventEffectBits = nullptr;
+    const uint32_t* m_postingOffsets = nullptr;
+    const int32_t* m_postings = nullptr;
+    vector<NewsTemplate> m_templates; //이벤트별 뉴스 문장 조각
+
+    IdSpan ids(uint32_t begin, uint32_t count) const { return { m_ids + begin, m_ids + begin + count }; }
+    //헤더와 모든 구역/레코드가 범위 안에 있는지 검사한 뒤 포인터를 잡음
+    bool attach(const char* data, size_t size, string* error);
+    static shared_ptr<const Scenario> fromBlob(const vector<char>& blob, string* error);
+};
+
+#endif // SCENARIO_H
@@ -0,0 +1,92 @@
+﻿// 시나리오 컴파일러
+// JSON 작성 파일을 검사해서 바로 매핑해 쓸 수 있는 바이너리(.sgsc)로 만듭니다. (빌드 단계에서 실행)
+//
+// 사용법: stockScenario <input.json> <output.sgsc>
+//         stockScenario --dump-default <output.json>   내장 기본 시나리오를 JSON으로 저장
+//         stockScenario --synthetic N <output.sgsc>     회사 N개짜리 합성 시나리오 (부하 테스트용)
+//         stockScenario --info <file>                   요약과 로드 시간 출력
+#include "Market.h"
+#include "Synthetic.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+bool readFile(const char* path, string& out) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    char buf[65536];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.append(buf, n);
+    fclose(f);
+    return true;
+}
+
+bool writeFile(const char* path, const char* data, size_t size) {
+    FILE* f = fopen(path, "wb");
+    if (!f) { fprintf(stderr, "cannot write %s\n", path); return false; }
+    bool ok = fwrite(data, 1, size, f) == size;
+    ok = (fclose(f) == 0) && ok;
+    if (!ok) fprintf(stderr, "error while writing %s\n", path);
+    return ok;
+}
+
+bool writeBlob(const ScenarioSource& source, const char* path) {
+    vector<string> warnings;
+    vector<char> blob = Scenario::compile(source, &warnings);
+    for (const auto& w : warnings) fprintf(stderr, "warning: %s\n", w.c_str());
+    return writeFile(path, blob.data(), blob.size());
+}
+
+int compile(const char* input, const char* output) {
+    string text;
+    if (!readFile(input, text)) { fprintf(stderr, "cannot open %s\n", input); return 1; }
+    ScenarioSource source;
+    string error;
+    if (!scenarioFromJson(text, source, &error)) { fprintf(stderr, "%s:%s\n", input, error.c_str()); return 1; }
+    return writeBlob(source, output) ? 0 : 1;
+}
+
+int info(const char* path) {
+    auto start = chrono::steady_clock::now();
+    string error;
+    shared_ptr<const Scenario> scenario = Scenario::load(path, &error);
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    if (!scenario) { fprintf(stderr, "%s\n", error.c_str()); return 1; }
+
+    const Scenario& s = *scenario;
+    printf("%s: %s, %zu bytes, loaded in %.3f ms\n", path, s.isMapped() ? "mapped" : "compiled in memory",
+           s.byteSize(), ms);
+    printf("  rules    : start %.0f, goal %.0f, %d days\n", s.startCash(), s.goal(), s.lastDay());
+    printf("  companies: %d\n  features : %d\n  effects  : %d\n  events   : %d\n  news     : %d\n",
+           s.companyCount(), s.featureCount(), s.effectCount(), s.eventCount(), s.newsCount());
+    return 0;
+}
+
+void usage(const char* argv0) {
+    fprintf(stderr, "usage: %s <input.json> <output.sgsc>\n"
+                    "       %s --dump-default <output.json>\n"
+                    "       %s --synthetic <companies> <output.sgsc>\n"
+                    "       %s --info <file>\n", argv0, argv0, argv0, argv0);
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc == 3 && !strcmp(argv[1], "--dump-default")) {
+        string json = scenarioToJson(defaultScenarioSource());
+        return writeFile(argv[2], json.data(), json.size()) ? 0 : 1;
+    }
+    if (argc == 4 && !strcmp(argv[1], "--synthetic")) {
+        SyntheticSpec spec;
+        spec.companies = atoi(argv[2]);
+        if (spec.companies <= 0) { usage(argv[0]); return 1; }
+        return writeBlob(makeSyntheticSource(spec), argv[3]) ? 0 : 1;
+    }
+    if (argc == 3 && !strcmp(argv[1], "--info")) return info(argv[2]);
+    if (argc == 3 && argv[1][0] != '-') return compile(argv[1], argv[2]);
+    usage(argv[0]);
+    return 1;
+}
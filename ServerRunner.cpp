@@ -0,0 +1,79 @@
+﻿// 헤드리스 게임 서버
+// 한 프로세스에서 게임 세션 수천 개를 돌립니다. 프로토콜은 GameServer.h 참고. (부하 테스트: stockLoad)
+// SIGINT/SIGTERM을 받으면 연결을 닫고 끝납니다.
+//
+// 사용법: stockServer [--port P] [--workers W] [--public] [--scenario file.json|file.sgsc]
+#include "GameServer.h"
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+struct Options {
+    int port = 7420;
+    unsigned workers = thread::hardware_concurrency();
+    bool publicBind = false; //모든 인터페이스에 바인드 (기본은 127.0.0.1)
+    const char* scenario = nullptr; //없으면 내장 기본 시나리오
+};
+
+bool parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        const char* v = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!strcmp(a, "--port") && v) { opt.port = atoi(v); i++; }
+        else if (!strcmp(a, "--workers") && v) { opt.workers = (unsigned)atoi(v); i++; }
+        else if (!strcmp(a, "--public")) { opt.publicBind = true; }
+        else if (!strcmp(a, "--scenario") && v) { opt.scenario = v; i++; }
+        else return false;
+    }
+    return opt.port >= 0 && opt.port <= 65535;
+}
+
+GameServer* g_server = nullptr;
+
+void onSignal(int) {
+    if (g_server) g_server->stop();
+}
+
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        fprintf(stderr, "usage: %s [--port P] [--workers W] [--public] [--scenario file]\n", argv[0]);
+        return 1;
+    }
+
+    shared_ptr<const Scenario> scenario = Scenario::builtin();
+    if (opt.scenario) {
+        string error;
+        scenario = Scenario::load(opt.scenario, &error);
+        if (!scenario) { fprintf(stderr, "%s\n", error.c_str()); return 1; }
+    }
+
+    GameServer::Config config;
+    config.port = (uint16_t)opt.port;
+    config.workers = opt.workers;
+    config.loopbackOnly = !opt.publicBind;
+    GameServer server(scenario, config);
+    string error;
+    if (!server.start(&error)) { fprintf(stderr, "%s\n", error.c_str()); return 1; }
+
+    g_server = &server;
+    struct sigaction sa{};
+    sa.sa_handler = onSignal;
+    sigaction(SIGINT, &sa, nullptr);
+    sigaction(SIGTERM, &sa, nullptr);
+
+    printf("listening on %s:%u (%u workers, %d companies, %d events)\n", opt.publicBind ? "0.0.0.0" : "127.0.0.1",
+           (unsigned)server.port(), max(1u, opt.workers), scenario->companyCount(), scenario->eventCount());
+    fflush(stdout);
+    server.run();
+    g_server = nullptr;
+
+    const GameServer::Stats s = server.stats();
+    printf("stopped: %llu commands\n", (unsigned long long)s.commands);
+    return 0;
+}
@@ -0,0 +1,127 @@
+﻿#ifndef STOCKLISTMODEL_H
+#define STOCKLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QString>
+#include <QVector>
+#include "Market.h"
+
+// 종목 목록 모델 (QML GridView/ListView에 직접 연결)
+// 이름/설명은 로드 시 한 번만 QString으로 바꿔 두고,
+// sync()는 마지막으로 알린 값과 비교해서 바뀐 행/역할만 dataChanged로 알립니다.
+class StockListModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    enum Roles {
+        NameRole = Qt::UserRole + 1,
+        PriceRole,
+        OwnedRole,
+        ChangeRateRole,
+        DescriptionRole,
+    };
+
+    explicit StockListModel(const Market* market, QObject *parent = nullptr)
+        : QAbstractListModel(parent), m_market(market) { reset(); }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override {
+        return parent.isValid() ? 0 : (int)m_rows.size();
+    }
+
+    QVariant data(const QModelIndex &index, int role) const override {
+        if (!index.isValid() || index.row() >= (int)m_rows.size()) return QVariant();
+        const Row& r = m_rows[index.row()];
+        switch (role) {
+        case NameRole: return r.name;
+        case PriceRole: return r.price;
+        case OwnedRole: return r.owned;
+        case ChangeRateRole: return r.changeRate;
+        case DescriptionRole: return r.description;
+        }
+        return QVariant();
+    }
+
+    QHash<int, QByteArray> roleNames() const override {
+        return {
+            { NameRole, "name" },
+            { PriceRole, "price" },
+            { OwnedRole, "owned" },
+            { ChangeRateRole, "changeRate" },
+            { DescriptionRole, "description" },
+        };
+    }
+
+    //시장(회사 목록)이 통째로 바뀌었을 때만 사용 (문자열 변환 포함)
+    void setMarket(const Market* market) { m_market = market; reset(); }
+
+    void reset() {
+        beginResetModel();
+        m_rows.clear();
+        m_rows.reserve(m_market->companyCount());
+        for (int i = 0; i < m_market->companyCount(); i++) {
+            m_rows.append({ toQString(m_market->companyName(i)), toQString(m_market->companyDescription(i)),
+                            m_market->price(i), m_market->owned(i), m_market->changeRate(i) });
+        }
+        endResetModel();
+    }
+
+    //시장 상태와 비교해서 바뀐 값만 알림 (같은 역할이 바뀐 연속된 행은 한 번에 묶음)
+    void sync() {
+        int runStart = -1;
+        int runMask = 0;
+        for (int i = 0; i <= (int)m_rows.size(); i++) {
+            int mask = 0;
+            if (i < (int)m_rows.size()) {
+                Row& r = m_rows[i];
+                double price = m_market->price(i);
+                int owned = m_market->owned(i);
+                double changeRate = m_market->changeRate(i);
+                if (r.price != price) { r.price = price; mask |= PriceBit; }
+                if (r.owned != owned) { r.owned = owned; mask |= OwnedBit; }
+                if (r.changeRate != changeRate) { r.changeRate = changeRate; mask |= ChangeRateBit; }
+            }
+            if (mask != runMask) {
+                if (runMask) emitRange(runStart, i - 1, runMask);
+                runStart = i;
+                runMask = mask;
+            }
+        }
+    }
+
+    //한 행만 확인 (매수/매도 직후)
+    void syncRow(int row) {
+        if (row < 0 || row >= (int)m_rows.size()) return;
+        Row& r = m_rows[row];
+        int mask = 0;
+        if (r.price != m_market->price(row)) { r.price = m_market->price(row); mask |= PriceBit; }
+        if (r.owned != m_market->owned(row)) { r.owned = m_market->owned(row); mask |= OwnedBit; }
+        if (r.changeRate != m_market->changeRate(row)) { r.changeRate = m_market->changeRate(row); mask |= ChangeRateBit; }
+        if (mask) emitRange(row, row, mask);
+    }
+
+private:
+    struct Row {
+        QString name;
+        QString description;
+        double price;
+        int owned;
+        double changeRate;
+    };
+
+    enum { PriceBit = 1, OwnedBit = 2, ChangeRateBit = 4 };
+
+    const Market* m_market;
+    QVector<Row> m_rows;
+
+    static QString toQString(string_view s) { return QString::fromUtf8(s.data(), (qsizetype)s.size()); }
+
+    void emitRange(int first, int last, int mask) {
+        QList<int> roles;
+        if (mask & PriceBit) roles.append(PriceRole);
+        if (mask & OwnedBit) roles.append(OwnedRole);
+        if (mask & ChangeRateBit) roles.append(ChangeRateRole);
+        emit dataChanged(index(first), index(last), roles);
+    }
+};
+
+#endif // STOCKLISTMODEL_H
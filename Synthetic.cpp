@@ -0,0 +1,65 @@
+﻿#include "Synthetic.h"
+#include "Random.h"
+#include <algorithm>
+
+ScenarioSource makeSyntheticSource(const SyntheticSpec& spec) {
+    //데이터 생성 전용 난수열 (게임 진행 난수와 겹치지 않도록 날짜 자리에 최댓값 사용)
+    RandomStream rng(spec.seed, 0, 0xFFFFFFFFu, 0);
+
+    vector<string> featureNames;
+    for (int f = 0; f < spec.features; f++) featureNames.push_back("특징" + to_string(f));
+
+    //특징 여러 개를 중복 없이 고르기
+    auto pickFeatures = [&](int count) {
+        vector<string> picked;
+        count = min(count, spec.features);
+        while ((int)picked.size() < count) {
+            const string& name = featureNames[rng.random_num(0, spec.features - 1)];
+            if (find(picked.begin(), picked.end(), name) == picked.end()) picked.push_back(name);
+        }
+        return picked;
+    };
+
+    ScenarioSource source;
+    source.lastDay = spec.lastDay;
+
+    vector<CompanyInfo>& companies = source.companies;
+    companies.reserve(spec.companies);
+    for (int c = 0; c < spec.companies; c++) {
+        double price = rng.random_num(10, 200) * 1000.0;
+        companies.push_back({"종목" + to_string(c), price, pickFeatures(spec.featuresPerCompany),
+                             "합성 종목 " + to_string(c)});
+    }
+
+    vector<Effect>& effects = source.effects;
+    effects.reserve(spec.effects);
+    for (int e = 0; e < spec.effects; e++) {
+        int impact = rng.random_num(2, 5) * (e % 2 == 0 ? 1 : -1);
+        effects.push_back({"이펙트" + to_string(e), impact, rng.random_num(4, 12)});
+    }
+
+    vector<Event>& events = source.events;
+    events.reserve(spec.events);
+    for (int e = 0; e < spec.events; e++) {
+        Event ev{};
+        ev.name = "이벤트" + to_string(e);
+        ev.single = rng.roll(70);
+        ev.impact = rng.random_num(-20, 22);
+        ev.stackable = ev.impact < 0;
+        //열에 하나는 전체 대상 이벤트
+        if (spec.targetsPerEvent > 0 && e % 10 != 0) ev.target = pickFeatures(spec.targetsPerEvent);
+        if (spec.effects > 0 && rng.roll(85)) ev.effect.push_back(effects[rng.random_num(0, spec.effects - 1)].name);
+        ev.cooltime = rng.random_num(3, 7);
+        ev.current_cooltime = 0;
+        ev.sentence = ev.single ? "<company>, 합성 이벤트 " + to_string(e) + " 발생" : "합성 이벤트 " + to_string(e) + " 발생";
+        ev.chance = rng.random_num(1, 20);
+        events.push_back(move(ev));
+    }
+
+    for (int n = 0; n < spec.newsCount; n++) source.news.push_back("합성 일반 뉴스 " + to_string(n));
+    return source;
+}
+
+Market makeSyntheticMarket(const SyntheticSpec& spec) {
+    return Market(Scenario::fromSource(makeSyntheticSource(spec)), spec.seed);
+}
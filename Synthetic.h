@@ -0,0 +1,24 @@
+﻿#ifndef SYNTHETIC_H
+#define SYNTHETIC_H
+
+#include "Market.h"
+
+// 벤치마크/부하 테스트용 합성 시장 설정
+// 같은 설정 + 같은 시드면 항상 같은 시장이 만들어집니다.
+struct SyntheticSpec {
+    int companies = 1000; //회사 수
+    int events = 100; //이벤트 수
+    int effects = 200; //이펙트 종류 수
+    int features = 32; //특징 종류 수
+    int featuresPerCompany = 3; //회사당 특징 수
+    int targetsPerEvent = 2; //이벤트당 타겟 특징 수 (0이면 전체 대상 이벤트가 섞임)
+    int newsCount = 30; //일반 뉴스 문장 수
+    int lastDay = 1 << 30; //사실상 끝나지 않는 게임
+    uint64_t seed = 1;
+};
+
+//합성 시나리오 작성용 데이터 (stockScenario로 파일로 만들 수도 있음)
+ScenarioSource makeSyntheticSource(const SyntheticSpec& spec);
+Market makeSyntheticMarket(const SyntheticSpec& spec);
+
+#endif // SYNTHETIC_H
@@ -0,0 +1,178 @@
+﻿#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// 워크 스틸링 스레드 풀
+// 워커마다 자기 큐를 가지고, 자기 큐는 뒤에서(LIFO) 꺼내고
+// 비었으면 다른 워커 큐의 앞에서(FIFO) 훔쳐옵니다.
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned threads = thread::hardware_concurrency()) {
+        if (threads == 0) threads = 1;
+        for (unsigned i = 0; i < threads; i++) m_queues.push_back(make_unique<Queue>());
+        for (unsigned i = 0; i < threads; i++) m_threads.emplace_back([this, i] { workerLoop(i); });
+    }
+
+    ~ThreadPool() {
+        {
+            lock_guard<mutex> lock(m_sleepMutex);
+            m_stop = true;
+        }
+        m_sleepCv.notify_all();
+        for (auto& t : m_threads) t.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return (unsigned)m_threads.size(); }
+
+    //작업 추가 (워커 안에서 호출하면 자기 큐, 밖에서 호출하면 라운드로빈)
+    void submit(function<void()> task) {
+        m_pending.fetch_add(1, memory_order_relaxed);
+        size_t q = (t_owner == this) ? t_index : (m_next.fetch_add(1, memory_order_relaxed) % m_queues.size());
+        {
+            lock_guard<mutex> lock(m_queues[q]->m);
+            m_queues[q]->tasks.push_back(move(task));
+        }
+        {
+            lock_guard<mutex> lock(m_sleepMutex);
+            m_signal++;
+        }
+        m_sleepCv.notify_one();
+    }
+
+    //제출된 모든 작업이 끝날 때까지 대기 (워커 밖에서 호출, 다른 호출자의 작업도 기다림)
+    void wait() {
+        unique_lock<mutex> lock(m_doneMutex);
+        m_doneCv.wait(lock, [this] { return m_pending.load(memory_order_acquire) == 0; });
+    }
+
+    //[begin, end) 구간을 grain 크기 조각으로 나눠 병렬 실행
+    //조각 경계가 스레드 수와 무관하므로 조각 단위 결과는 항상 같습니다.
+    //이 호출의 조각만 세는 래치로 기다리고, 기다리는 동안 호출한 스레드도 큐의 작업을 꺼내 돌리므로
+    //작업 안에서 다시 parallelFor를 불러도 막히지 않고, 동시에 부른 다른 호출자를 기다리지도 않습니다.
+    void parallelFor(size_t begin, size_t end, size_t grain, const function<void(size_t, size_t)>& fn) {
+        if (begin >= end) return;
+        if (grain == 0) grain = 1;
+        if (end - begin <= grain || size() == 1) { fn(begin, end); return; }
+        Latch latch;
+        latch.remaining.store((end - begin + grain - 1) / grain, memory_order_relaxed);
+        for (size_t lo = begin; lo < end; lo += grain) {
+            size_t hi = min(end, lo + grain);
+            submit([&fn, &latch, lo, hi] {
+                fn(lo, hi);
+                //줄이기와 깨우기를 모두 잠금 안에서 해야, 호출자가 0을 보고 래치를 없앨 때 이 스레드가 손을 뗀 상태
+                lock_guard<mutex> lock(latch.m);
+                if (latch.remaining.fetch_sub(1, memory_order_acq_rel) == 1) latch.cv.notify_all();
+            });
+        }
+        function<void()> task;
+        while (latch.remaining.load(memory_order_acquire) > 0) {
+            if (tryPop(task)) { run(task); continue; }
+            //큐가 비었으면 남은 조각은 모두 다른 스레드가 돌리는 중
+            unique_lock<mutex> lock(latch.m);
+            latch.cv.wait(lock, [&] { return latch.remaining.load(memory_order_acquire) == 0; });
+        }
+        //잠금 밖에서 0을 봤어도 마지막 조각이 아직 깨우는 중일 수 있으므로, 그 잠금이 풀릴 때까지 기다린 뒤 반환
+        lock_guard<mutex> lock(latch.m);
+    }
+
+private:
+    struct Queue {
+        mutex m;
+        deque<function<void()>> tasks;
+    };
+
+    //parallelFor 한 번의 남은 조각 수 (호출자 스택에 있음, 줄이기는 m 안에서만)
+    struct Latch {
+        atomic<size_t> remaining{0};
+        mutex m;
+        condition_variable cv;
+    };
+
+    vector<unique_ptr<Queue>> m_queues;
+    vector<thread> m_threads;
+    atomic<size_t> m_pending{0};
+    atomic<size_t> m_next{0};
+
+    mutex m_sleepMutex;
+    condition_variable m_sleepCv;
+    size_t m_signal = 0;
+    bool m_stop = false;
+
+    mutex m_doneMutex;
+    condition_variable m_doneCv;
+
+    static inline thread_local ThreadPool* t_owner = nullptr;
+    static inline thread_local size_t t_index = 0;
+
+    bool popLocal(size_t self, function<void()>& out) {
+        Queue& q = *m_queues[self];
+        lock_guard<mutex> lock(q.m);
+        if (q.tasks.empty()) return false;
+        out = move(q.tasks.back());
+        q.tasks.pop_back();
+        return true;
+    }
+
+    //워커면 자기 큐 → 훔치기, 워커 밖이면 모든 큐에서 훔치기
+    bool tryPop(function<void()>& out) {
+        if (t_owner == this) return popLocal(t_index, out) || steal(t_index, out);
+        return steal(0, out, 0);
+    }
+
+    bool steal(size_t self, function<void()>& out, size_t first = 1) {
+        for (size_t k = first; k < m_queues.size(); k++) {
+            Queue& q = *m_queues[(self + k) % m_queues.size()];
+            lock_guard<mutex> lock(q.m);
+            if (q.tasks.empty()) continue;
+            out = move(q.tasks.front());
+            q.tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    void run(function<void()>& task) {
+        task();
+        task = nullptr;
+        if (m_pending.fetch_sub(1, memory_order_acq_rel) == 1) {
+            lock_guard<mutex> lock(m_doneMutex);
+            m_doneCv.notify_all();
+        }
+    }
+
+    void workerLoop(size_t self) {
+        t_owner = this;
+        t_index = self;
+        function<void()> task;
+        while (true) {
+            size_t seen;
+            {
+                lock_guard<mutex> lock(m_sleepMutex);
+                seen = m_signal;
+            }
+            if (popLocal(self, task) || steal(self, task)) {
+                run(task);
+                continue;
+            }
+            //일이 없으면 새 작업 신호가 올 때까지 잠듦
+            unique_lock<mutex> lock(m_sleepMutex);
+            m_sleepCv.wait(lock, [&] { return m_stop || m_signal != seen; });
+            if (m_stop) return;
+        }
+    }
+};
+
+#endif // THREADPOOL_H
@@ -1,6 +1,10 @@
 ﻿#include <QGuiApplication>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFileInfo>
+#include <QStandardPaths>
 #include "GameBackend.h" // 통합된 헤더 파일 포함
 
 int main(int argc, char *argv[])
@@ -11,8 +15,57 @@ int main(int argc, char *argv[])
 
     QGuiApplication app(argc, argv);
 
-    // 1. 백엔드 생성 (생성자에서 initData가 실행됨)
-    GameBackend backend;
+    // 0. --seed 옵션 (지정하지 않으면 무작위 시드), --scenario 옵션 (JSON 또는 컴파일된 .sgsc)
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption seedOption("seed", "게임을 재현할 난수 시드", "seed");
+    QCommandLineOption scenarioOption("scenario", "시나리오 파일 (.json 또는 .sgsc)", "file");
+    QCommandLineOption saveDirOption("save-dir", "세이브/저널을 저장할 폴더", "dir");
+    QCommandLineOption noSaveOption("no-save", "게임을 저장하지 않음");
+    QCommandLineOption intradayOption("intraday", "장중 틱 모드: 하루를 나눌 틱 수 (예: 390)", "ticks");
+    parser.addOption(seedOption);
+    parser.addOption(scenarioOption);
+    parser.addOption(saveDirOption);
+    parser.addOption(noSaveOption);
+    parser.addOption(intradayOption);
+    parser.process(app);
+
+    // 지정하지 않으면 실행 파일 옆의 scenarios/default.sgsc, 그것도 없으면 내장 기본 시나리오
+    QString scenarioPath = parser.value(scenarioOption);
+    if (scenarioPath.isEmpty()) {
+        QString bundled = QDir(QCoreApplication::applicationDirPath()).filePath("scenarios/default.sgsc");
+        if (QFileInfo::exists(bundled)) scenarioPath = bundled;
+    }
+    shared_ptr<const Scenario> scenario = Scenario::builtin();
+    if (!scenarioPath.isEmpty()) {
+        string error;
+        scenario = Scenario::load(scenarioPath.toStdString(), &error);
+        if (!scenario) {
+            qCritical() << "Cannot load scenario:" << QString::fromStdString(error);
+            return 1;
+        }
+        qInfo() << "StockGame scenario:" << scenarioPath;
+    }
+
+    bool seedOk = false;
+    quint64 seed = parser.value(seedOption).toULongLong(&seedOk);
+    if (!seedOk) seed = Market::randomSeed();
+    qInfo() << "StockGame seed:" << seed;
+
+    // 1. 백엔드 생성 (시나리오 데이터는 복사 없이 공유)
+    GameBackend backend(scenario, seed);
+    if (parser.isSet(intradayOption)) {
+        IntradayConfig intraday;
+        intraday.ticks = parser.value(intradayOption).toInt();
+        backend.setIntraday(intraday);
+    }
+
+    // 저장 (입력 저널 + 주기적 스냅샷), 이전 게임이 남아 있으면 메인 메뉴에서 이어하기 가능
+    if (!parser.isSet(noSaveOption)) {
+        QString saveDir = parser.value(saveDirOption);
+        if (saveDir.isEmpty()) saveDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+        backend.setSaveDirectory(saveDir);
+    }
 
     QQmlApplicationEngine engine;
 